@@ -0,0 +1,227 @@
+// Microbenchmarks for the pevents hot paths, reporting ns/op with percentiles so releases can be
+// compared against one another. Build with -Dbenchmark=true and run the `benchmark` executable;
+// the WFMO scenarios are only compiled when the library is built with WFMO support.
+//
+// These are latency benchmarks, not correctness tests: each scenario times individual operations
+// and reports the mean alongside p50/p90/p99 of the sampled distribution, since tail latency is
+// what a pevents upgrade is most likely to regress.
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+namespace {
+    typedef std::chrono::steady_clock bench_clock;
+
+    uint64_t Elapsed(bench_clock::time_point start) {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   bench_clock::now() - start)
+            .count();
+    }
+
+    void Report(const char *name, std::vector<uint64_t> &samples) {
+        std::sort(samples.begin(), samples.end());
+
+        uint64_t sum = 0;
+        for (size_t i = 0; i < samples.size(); ++i) {
+            sum += samples[i];
+        }
+
+        size_t n = samples.size();
+        printf("%-44s %9.1f ns/op  p50 %8llu  p90 %8llu  p99 %8llu  (%zu samples)\n", name,
+               (double)sum / n, (unsigned long long)samples[n / 2],
+               (unsigned long long)samples[(size_t)(n * 0.90)],
+               (unsigned long long)samples[(size_t)(n * 0.99)], n);
+    }
+
+    // Uncontended signal-then-wait round trip on a single thread: the floor for the common case
+    // of an auto-reset event handed from a producer to an already-running consumer.
+    void BenchUncontendedRoundTrip() {
+        const int iterations = 200000;
+        neosmart_event_t event = CreateEvent(false, false);
+
+        std::vector<uint64_t> samples;
+        samples.reserve(iterations);
+        for (int i = 0; i < iterations; ++i) {
+            bench_clock::time_point start = bench_clock::now();
+            SetEvent(event);
+            WaitForEvent(event);
+            samples.push_back(Elapsed(start));
+        }
+
+        DestroyEvent(event);
+        Report("SetEvent/WaitForEvent round trip", samples);
+    }
+
+    // N producers signaling an auto-reset event in a tight loop while M consumers wait on it;
+    // each sample is the latency of one consumer-side WaitForEvent() call under contention.
+    void BenchAutoResetContention(int producers, int consumers) {
+        const int handoffsPerConsumer = 20000;
+        neosmart_event_t event = CreateEvent(false, false);
+        std::atomic<bool> stop(false);
+        std::atomic<int> consumed(0);
+        const int totalHandoffs = handoffsPerConsumer * consumers;
+
+        std::vector<std::thread> producerThreads;
+        for (int i = 0; i < producers; ++i) {
+            producerThreads.push_back(std::thread([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    SetEvent(event);
+                }
+            }));
+        }
+
+        std::vector<std::vector<uint64_t>> perConsumer(consumers);
+        std::vector<std::thread> consumerThreads;
+        for (int i = 0; i < consumers; ++i) {
+            std::vector<uint64_t> *samples = &perConsumer[i];
+            consumerThreads.push_back(std::thread([&, samples] {
+                samples->reserve(handoffsPerConsumer);
+                for (int j = 0; j < handoffsPerConsumer; ++j) {
+                    bench_clock::time_point start = bench_clock::now();
+                    WaitForEvent(event);
+                    samples->push_back(Elapsed(start));
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }));
+        }
+
+        for (size_t i = 0; i < consumerThreads.size(); ++i) {
+            consumerThreads[i].join();
+        }
+        stop.store(true, std::memory_order_relaxed);
+        for (size_t i = 0; i < producerThreads.size(); ++i) {
+            producerThreads[i].join();
+        }
+        (void)totalHandoffs;
+
+        std::vector<uint64_t> samples;
+        for (int i = 0; i < consumers; ++i) {
+            samples.insert(samples.end(), perConsumer[i].begin(), perConsumer[i].end());
+        }
+
+        DestroyEvent(event);
+        char name[64];
+        snprintf(name, sizeof(name), "auto-reset contention %dp/%dc wait", producers, consumers);
+        Report(name, samples);
+    }
+
+    // One manual-reset broadcast to K blocked waiters per sample; the sample is the time from
+    // SetEvent() until the last waiter has observed the wakeup.
+    void BenchManualResetBroadcast(int waiters) {
+        const int rounds = 2000;
+        neosmart_event_t go = CreateEvent(true, false);
+        neosmart_event_t done = CreateEvent(false, false);
+        std::atomic<int> awake(0);
+        std::atomic<bool> stop(false);
+        neosmart_event_t ready = CreateEvent(false, false);
+        std::atomic<int> parked(0);
+
+        std::vector<std::thread> waiterThreads;
+        for (int i = 0; i < waiters; ++i) {
+            waiterThreads.push_back(std::thread([&] {
+                for (;;) {
+                    if (parked.fetch_add(1, std::memory_order_acq_rel) + 1 == waiters) {
+                        SetEvent(ready);
+                    }
+                    WaitForEvent(go);
+                    if (stop.load(std::memory_order_acquire)) {
+                        return;
+                    }
+                    if (awake.fetch_add(1, std::memory_order_acq_rel) + 1 == waiters) {
+                        SetEvent(done);
+                    }
+                    // Wait for the coordinator to rearm before parking for the next round
+                    while (WaitForEvent(go, 0) == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            }));
+        }
+
+        std::vector<uint64_t> samples;
+        samples.reserve(rounds);
+        for (int i = 0; i < rounds; ++i) {
+            WaitForEvent(ready);
+            parked.store(0, std::memory_order_release);
+            awake.store(0, std::memory_order_release);
+
+            bench_clock::time_point start = bench_clock::now();
+            SetEvent(go);
+            WaitForEvent(done);
+            samples.push_back(Elapsed(start));
+
+            ResetEvent(go);
+        }
+
+        WaitForEvent(ready);
+        stop.store(true, std::memory_order_release);
+        SetEvent(go);
+        for (size_t i = 0; i < waiterThreads.size(); ++i) {
+            waiterThreads[i].join();
+        }
+
+        DestroyEvent(go);
+        DestroyEvent(done);
+        DestroyEvent(ready);
+        char name[64];
+        snprintf(name, sizeof(name), "manual-reset broadcast to %d waiters", waiters);
+        Report(name, samples);
+    }
+
+#ifdef WFMO
+    // The cost of registering with (and then unregistering from) N unsignaled events: a zero
+    // timeout WaitForMultipleEvents() call pays for the full registration loop and nothing else.
+    void BenchWfmoRegistration(int count) {
+        const int iterations = 50000;
+        std::vector<neosmart_event_t> events(count);
+        for (int i = 0; i < count; ++i) {
+            events[i] = CreateEvent(false, false);
+        }
+
+        std::vector<uint64_t> samples;
+        samples.reserve(iterations);
+        for (int i = 0; i < iterations; ++i) {
+            bench_clock::time_point start = bench_clock::now();
+            WaitForMultipleEvents(&events[0], count, true, 0);
+            samples.push_back(Elapsed(start));
+        }
+
+        for (int i = 0; i < count; ++i) {
+            DestroyEvent(events[i]);
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "WFMO registration, %d events", count);
+        Report(name, samples);
+    }
+#endif
+} // namespace
+
+int main() {
+    unsigned hardware = std::thread::hardware_concurrency();
+    printf("pevents benchmark (%u hardware threads)\n\n", hardware ? hardware : 1);
+
+    BenchUncontendedRoundTrip();
+    BenchAutoResetContention(1, 1);
+    BenchAutoResetContention(4, 4);
+    BenchManualResetBroadcast(4);
+    BenchManualResetBroadcast(16);
+#ifdef WFMO
+    BenchWfmoRegistration(1);
+    BenchWfmoRegistration(4);
+    BenchWfmoRegistration(16);
+    BenchWfmoRegistration(64);
+#endif
+
+    return 0;
+}
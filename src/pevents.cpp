@@ -11,565 +11,3544 @@
 #include <assert.h>
 #include <errno.h>
 #include <pthread.h>
-#include <sys/time.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
 #include <atomic>
 #include <memory>
+#include <new>
+#include <queue>
+#include <unordered_map>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#else
+#include <fcntl.h>
+#endif
+
+#ifdef FUTEX
+#ifndef __linux__
+#error The FUTEX event implementation is only available on Linux!
+#endif
+#ifdef WFMO
+#error The FUTEX event implementation does not support WaitForMultipleEvents()!
+#endif
+#ifdef PULSE
+#error The FUTEX event implementation does not support PulseEvent()!
+#endif
+#ifdef CORO
+#error The FUTEX event implementation does not support coroutine awaiters!
+#endif
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#else
+#include <utility>
+#include <vector>
 #ifdef WFMO
-#include <algorithm>
 #include <deque>
 #endif
+#endif // FUTEX
 
 namespace neosmart {
-#ifdef WFMO
-    // Each call to WaitForMultipleObjects initializes a neosmart_wfmo_t object which tracks
-    // the progress of the caller's multi-object wait and dispatches responses accordingly.
-    // One neosmart_wfmo_t struct is shared for all events in a single WFMO call
-    struct neosmart_wfmo_t_ {
-        pthread_mutex_t Mutex;
-        pthread_cond_t CVariable;
-        std::atomic<int> RefCount;
-        union {
-            int FiredEvent; // WFSO
-            int EventsLeft; // WFMO
-        } Status;
-        bool WaitAll;
-        std::atomic<bool> StillWaiting;
+    // One iteration of a spin-wait loop: relinquish pipeline resources to the sibling
+    // hyperthread (x86 `pause` / ARM `yield`) without giving up the core.
+    static inline void SpinPause() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
 
-        void Destroy() {
-            pthread_mutex_destroy(&Mutex);
-            pthread_cond_destroy(&CVariable);
+    // Bounds for the per-event adaptive spin budget (in SpinPause() iterations). The budget is
+    // doubled each time a spin successfully absorbs a wait and halved each time the spinner
+    // falls through to the blocking path, so events whose observed signal latency exceeds the
+    // spin window quickly stop paying for it.
+    static const uint32_t SpinBudgetMin = 1 << 6;
+    static const uint32_t SpinBudgetDefault = 1 << 9;
+    static const uint32_t SpinBudgetMax = 1 << 14;
+
+    // Assumed destructive-interference granularity for the arena layout of CreateEventArray()
+    static const size_t EventCacheLineSize = 64;
+
+    // The pollable-fd bridge behind GetEventFd(): on Linux the fd is an eventfd (read and write
+    // ends are one and the same); elsewhere it's a non-blocking self-pipe and the two ends
+    // differ. The fd is kept readable exactly while the event's state is signaled.
+    static int CreateBridgeFd(int &writeFd) {
+#ifdef __linux__
+        int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        writeFd = fd;
+        return fd;
+#else
+        int fds[2];
+        if (pipe(fds) != 0) {
+            writeFd = -1;
+            return -1;
         }
-    };
-    typedef neosmart_wfmo_t_ *neosmart_wfmo_t;
+        for (int i = 0; i < 2; ++i) {
+            fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+            fcntl(fds[i], F_SETFD, fcntl(fds[i], F_GETFD) | FD_CLOEXEC);
+        }
+        writeFd = fds[1];
+        return fds[0];
+#endif
+    }
 
-    // A neosmart_wfmo_info_t object is registered with each event waited on in a WFMO
-    // This reference to neosmart_wfmo_t_ is how the event knows whom to notify when triggered
-    struct neosmart_wfmo_info_t_ {
-        neosmart_wfmo_t Waiter;
-        int WaitIndex;
+    static void SignalBridgeFd(int writeFd) {
+#ifdef __linux__
+        uint64_t one = 1;
+        ssize_t result = write(writeFd, &one, sizeof(one));
+#else
+        char byte = 1;
+        ssize_t result = write(writeFd, &byte, sizeof(byte));
+#endif
+        (void)result;
+    }
+
+    static void DrainBridgeFd(int fd) {
+#ifdef __linux__
+        // An eventfd read retrieves (and zeroes) the whole counter in one go
+        uint64_t value;
+        ssize_t result = read(fd, &value, sizeof(value));
+        (void)result;
+#else
+        char buffer[64];
+        while (read(fd, buffer, sizeof(buffer)) > 0) {
+        }
+#endif
+    }
+
+#ifdef STATS
+    // The live (atomic) counterpart of the neosmart_event_stats_t snapshot handed out by
+    // GetEventStats(). All increments are relaxed: the counters are diagnostics, not
+    // synchronization, and the paths that bump them already own the relevant cache lines.
+    struct neosmart_event_stats_internal_t_ {
+        std::atomic<uint64_t> Waits;
+        std::atomic<uint64_t> LockWaits;
+        std::atomic<uint64_t> SpuriousWakeups;
+        std::atomic<uint64_t> WaitersWoken;
+        std::atomic<uint64_t> ExpiredWaits;
     };
-    typedef neosmart_wfmo_info_t_ *neosmart_wfmo_info_t;
-#endif // WFMO
+#endif
+} // namespace neosmart
 
-    // The basic event structure, passed to the caller as an opaque pointer when creating events
+#ifdef STATS
+#define STAT_INC(event, field) (event)->Stats.field.fetch_add(1, std::memory_order_relaxed)
+#else
+#define STAT_INC(event, field) ((void)0)
+#endif
+
+#ifdef TRACE
+// USDT static tracepoints (systemtap <sys/sdt.h>, provider `pevents`) at the signal/wait
+// transitions, so external tooling (bpftrace, perf probe, systemtap) can attribute latency to
+// individual events in production — e.g. a signal-to-wake histogram keyed on the event pointer
+// from the `set` and `wait_end` probes. Each probe compiles to a single nop plus an ELF note
+// until a tracer arms it; without TRACE they vanish entirely.
+#include <sys/sdt.h>
+#define TRACE_PROBE1(name, a1) DTRACE_PROBE1(pevents, name, a1)
+#define TRACE_PROBE2(name, a1, a2) DTRACE_PROBE2(pevents, name, a1, a2)
+#define TRACE_PROBE3(name, a1, a2, a3) DTRACE_PROBE3(pevents, name, a1, a2, a3)
+#else
+#define TRACE_PROBE1(name, a1) ((void)0)
+#define TRACE_PROBE2(name, a1, a2) ((void)0)
+#define TRACE_PROBE3(name, a1, a2, a3) ((void)0)
+#endif
+
+#ifdef FUTEX
+namespace neosmart {
+    // A futex-backed event: `State` doubles as the futex word (0 = unsignaled, 1 = signaled), so
+    // an uncontended SetEvent() is a single atomic store and a contended wake is one FUTEX_WAKE
+    // syscall, with no mutex or condition variable anywhere in the signal/wait path.
     struct neosmart_event_t_ {
-        pthread_cond_t CVariable;
-        pthread_mutex_t Mutex;
+        std::atomic<int> State;
+        // The number of threads that are (or are about to be) parked in FUTEX_WAIT, maintained so
+        // that SetEvent() can skip the wake syscall entirely when no one is listening.
+        std::atomic<int> Waiters;
+        // See the spin budget discussion above; only consulted when `SpinWait` is set.
+        std::atomic<uint32_t> SpinBudget;
         bool AutoReset;
-        std::atomic<bool> State;
-#ifdef WFMO
-        std::deque<neosmart_wfmo_info_t_> RegisteredWaits;
+        bool SpinWait;
+        // A counted (semaphore-style) event stores its pending signal count in the futex word
+        // itself; plain events only ever hold 0 or 1 there. See CreateCountedEvent().
+        bool Counted;
+        // Lazily-created pollable eventfd mirroring the signaled state; -1 until GetEventFd()
+        std::atomic<int> BridgeFd;
+#ifdef STATS
+        // LockWaits and ExpiredWaits never move on this backend (there is no mutex and no WFMO)
+        neosmart_event_stats_internal_t_ Stats;
 #endif
     };
 
-#ifdef WFMO
-    static bool RemoveExpiredWaitHelper(neosmart_wfmo_info_t_ wait) {
-        if (wait.Waiter->StillWaiting.load(std::memory_order_relaxed)) {
-            return false;
-        }
-
-        int ref_count = wait.Waiter->RefCount.fetch_sub(1, std::memory_order_acq_rel);
-        assert(ref_count > 0);
+    // Arena slot size for CreateEventArray(): the event padded out to whole cache lines
+    static inline size_t EventArrayStride() {
+        return (sizeof(neosmart_event_t_) + EventCacheLineSize - 1) & ~(EventCacheLineSize - 1);
+    }
 
-        if (ref_count == 1) {
-            wait.Waiter->Destroy();
-            delete wait.Waiter;
+    // Drain the bridge fd (if one has been attached) after consuming an auto-reset signal or
+    // resetting the event, so the fd stops polling as readable.
+    static inline void DrainBridge(neosmart_event_t event) {
+        int fd = event->BridgeFd.load(std::memory_order_relaxed);
+        if (fd != -1) {
+            DrainBridgeFd(fd);
         }
-        return true;
     }
-#endif // WFMO
-
-    neosmart_event_t CreateEvent(bool manualReset, bool initialState) {
-        neosmart_event_t event = new neosmart_event_t_;
-
-        int result = pthread_cond_init(&event->CVariable, 0);
-        assert(result == 0);
 
-        result = pthread_mutex_init(&event->Mutex, 0);
-        assert(result == 0);
+    static long futex(std::atomic<int> *addr, int op, int value, const timespec *timeout) {
+        static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex word must be a plain int");
+        return syscall(SYS_futex, reinterpret_cast<int *>(addr), op, value, timeout, nullptr, 0);
+    }
 
+    // Shared initialization for individually-allocated and arena-constructed events
+    static void InitializeEvent(neosmart_event_t event, bool manualReset, bool initialState,
+                                bool spinWait) {
         event->AutoReset = !manualReset;
+        event->SpinWait = spinWait;
+        event->Counted = false;
+        event->SpinBudget.store(SpinBudgetDefault, std::memory_order_relaxed);
+        event->Waiters.store(0, std::memory_order_relaxed);
+        event->BridgeFd.store(-1, std::memory_order_relaxed);
+#ifdef STATS
+        event->Stats.Waits.store(0, std::memory_order_relaxed);
+        event->Stats.LockWaits.store(0, std::memory_order_relaxed);
+        event->Stats.SpuriousWakeups.store(0, std::memory_order_relaxed);
+        event->Stats.WaitersWoken.store(0, std::memory_order_relaxed);
+        event->Stats.ExpiredWaits.store(0, std::memory_order_relaxed);
+#endif
         // memory_order_release: if `initialState == true`, allow a load with acquire semantics to
         // see the value.
-        event->State.store(initialState, std::memory_order_release);
+        event->State.store(initialState ? 1 : 0, std::memory_order_release);
+    }
 
+    PEVENTS_INLINE neosmart_event_t CreateEvent(bool manualReset, bool initialState, bool spinWait) {
+        neosmart_event_t event = new neosmart_event_t_;
+        InitializeEvent(event, manualReset, initialState, spinWait);
         return event;
     }
 
-    static int UnlockedWaitForEvent(neosmart_event_t event, uint64_t milliseconds) {
-        int result = 0;
-        // memory_order_relaxed: `State` is only set to true with the mutex held, and we require
-        // that this function only be called after the mutex is obtained.
-        if (!event->State.load(std::memory_order_relaxed)) {
-            // Zero-timeout event state check optimization
-            if (milliseconds == 0) {
-                return WAIT_TIMEOUT;
-            }
-
-            timespec ts;
-            if (milliseconds != WAIT_INFINITE) {
-                timeval tv;
-                gettimeofday(&tv, NULL);
-
-                uint64_t nanoseconds = ((uint64_t)tv.tv_sec) * 1000 * 1000 * 1000 +
-                                       milliseconds * 1000 * 1000 + ((uint64_t)tv.tv_usec) * 1000;
-
-                ts.tv_sec = (time_t) (nanoseconds / 1000 / 1000 / 1000);
-                ts.tv_nsec = (long) (nanoseconds - ((uint64_t)ts.tv_sec) * 1000 * 1000 * 1000);
-            }
+    PEVENTS_INLINE int CreateEventArray(neosmart_event_t *out, int count, bool manualReset,
+                                        bool initialState) {
+        assert(count > 0);
 
-            do {
-                // Regardless of whether it's an auto-reset or manual-reset event:
-                // wait to obtain the event, then lock anyone else out
-                if (milliseconds != WAIT_INFINITE) {
-                    result = pthread_cond_timedwait(&event->CVariable, &event->Mutex, &ts);
-                } else {
-                    result = pthread_cond_wait(&event->CVariable, &event->Mutex);
-                }
-                // memory_order_relaxed: ordering is guaranteed by the mutex, as `State = true` is
-                // only ever written with the mutex held.
-            } while (result == 0 && !event->State.load(std::memory_order_relaxed));
-        } else if (event->AutoReset) {
-            // It's an auto-reset event that's currently available;
-            // we need to stop anyone else from using it
-            result = 0;
-        }
-        else {
-            // We're trying to obtain a manual reset event with a signaled state; don't do anything
+        // One aligned arena for the whole block, with every event padded out to its own cache
+        // line(s) so the futex word of one event can't false-share with its neighbor's — and one
+        // allocator call instead of `count`.
+        void *arena = nullptr;
+        if (posix_memalign(&arena, EventCacheLineSize, EventArrayStride() * count) != 0) {
+            return ENOMEM;
         }
 
-        if (result == 0 && event->AutoReset) {
-            // We've only accquired the event if the wait succeeded
-            // memory_order_relaxed: we never act on `State == true` without fully synchronizing
-            // or grabbing the mutex, so it's OK to use relaxed semantics here.
-            event->State.store(false, std::memory_order_relaxed);
+        for (int i = 0; i < count; ++i) {
+            neosmart_event_t event =
+                new (static_cast<char *>(arena) + EventArrayStride() * i) neosmart_event_t_;
+            InitializeEvent(event, manualReset, initialState, false);
+            out[i] = event;
         }
 
-        return result;
+        return 0;
     }
 
-    int WaitForEvent(neosmart_event_t event, uint64_t milliseconds) {
-        // Optimization: bypass acquiring the event lock if the state atomic is unavailable.
-        // memory_order_relaxed: This is just an optimization, it's OK to be biased towards a stale
-        // value here, and preferable to synchronizing CPU caches to get a more accurate result.
-        if (milliseconds == 0 && !event->State.load(std::memory_order_relaxed)) {
-            return WAIT_TIMEOUT;
-        }
-        // Optimization: early return in case of success for manual reset events only.
-        if (!event->AutoReset && event->State.load(std::memory_order_relaxed)) {
-            // A memory barrier is required here. This is still cheaper than a syscall.
-            // See https://github.com/neosmart/pevents/issues/18
-            if (event->State.load(std::memory_order_acquire)) {
-                return 0;
+    PEVENTS_INLINE int DestroyEventArray(neosmart_event_t *events, int count) {
+        assert(count > 0);
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i]->BridgeFd.load(std::memory_order_relaxed);
+            if (fd != -1) {
+                close(fd);
             }
         }
+        // The first event sits at the arena's base address; see CreateEventArray()
+        free(events[0]);
 
-        int tempResult = pthread_mutex_lock(&event->Mutex);
-        assert(tempResult == 0);
+        return 0;
+    }
 
-        int result = UnlockedWaitForEvent(event, milliseconds);
+    PEVENTS_INLINE neosmart_event_t CreateCountedEvent(int initialCount, bool spinWait) {
+        assert(initialCount >= 0);
 
-        tempResult = pthread_mutex_unlock(&event->Mutex);
-        assert(tempResult == 0);
+        neosmart_event_t event = CreateEvent(false, false, spinWait);
+        event->Counted = true;
+        // memory_order_release: like the initial `State` store in CreateEvent()
+        event->State.store(initialCount, std::memory_order_release);
 
-        return result;
+        return event;
     }
 
-#ifdef WFMO
-    int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
-                              uint64_t milliseconds) {
-        int unused;
-        return WaitForMultipleEvents(events, count, waitAll, milliseconds, unused);
+    // Consume one unit of the event's signaled state without blocking: the whole state for a
+    // plain auto-reset event, one count for a counted one.
+    static bool TryConsume(neosmart_event_t event, std::memory_order order) {
+        int value = event->State.load(std::memory_order_relaxed);
+        while (value > 0) {
+            int replacement = event->Counted ? value - 1 : 0;
+            if (event->State.compare_exchange_weak(value, replacement, order,
+                                                   std::memory_order_relaxed)) {
+                if (replacement == 0) {
+                    DrainBridge(event);
+                }
+                return true;
+            }
+        }
+        return false;
     }
 
-    int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
-                              uint64_t milliseconds, int &waitIndex) {
-        neosmart_wfmo_t wfmo = new neosmart_wfmo_t_;
-
-        int result = 0;
-        int tempResult = pthread_mutex_init(&wfmo->Mutex, 0);
-        assert(tempResult == 0);
-
-        tempResult = pthread_cond_init(&wfmo->CVariable, 0);
-        assert(tempResult == 0);
-
-        neosmart_wfmo_info_t_ waitInfo;
-        waitInfo.Waiter = wfmo;
-        waitInfo.WaitIndex = -1;
-
-        if (waitAll) {
-            wfmo->Status.EventsLeft = count;
-        } else {
-            wfmo->Status.FiredEvent = -1;
+    // The shared blocking core: `deadline` is an absolute CLOCK_MONOTONIC time (or nullptr to
+    // wait forever); `poll` short-circuits to WAIT_TIMEOUT without parking.
+    static int WaitForEventCore(neosmart_event_t event, bool poll, const timespec *deadline) {
+        if (event->SpinWait && !poll) {
+            uint32_t budget = event->SpinBudget.load(std::memory_order_relaxed);
+            for (uint32_t spin = 0; spin < budget; ++spin) {
+                if (event->AutoReset) {
+                    if (event->State.load(std::memory_order_relaxed) > 0 &&
+                        TryConsume(event, std::memory_order_acquire)) {
+                        event->SpinBudget.store(budget < SpinBudgetMax ? budget * 2 : SpinBudgetMax,
+                                                std::memory_order_relaxed);
+                        return 0;
+                    }
+                } else if (event->State.load(std::memory_order_relaxed) == 1 &&
+                           event->State.load(std::memory_order_acquire) == 1) {
+                    event->SpinBudget.store(budget < SpinBudgetMax ? budget * 2 : SpinBudgetMax,
+                                            std::memory_order_relaxed);
+                    return 0;
+                }
+                SpinPause();
+            }
+            // The event wasn't signaled within the spin window; shrink it and fall back to
+            // parking in the kernel.
+            event->SpinBudget.store(budget > SpinBudgetMin ? budget / 2 : SpinBudgetMin,
+                                    std::memory_order_relaxed);
         }
 
-        wfmo->WaitAll = waitAll;
-        wfmo->StillWaiting.store(true, std::memory_order_release);
-        // memory_order_release: this is the initial value other threads should see
-        wfmo->RefCount.store(1 + count, std::memory_order_release);
-        // Separately keep track of how many refs to decrement after the initialization loop, to
-        // avoid repeatedly clearing the cache line.
-        int skipped_refs = 0;
-
-        tempResult = pthread_mutex_lock(&wfmo->Mutex);
-        assert(tempResult == 0);
-
-        bool done = false;
-        waitIndex = -1;
-
-        for (int i = 0; i < count; ++i) {
-            waitInfo.WaitIndex = i;
-
-            // Skip obtaining the mutex for manual reset events. This requires a memory barrier to
-            // ensure correctness.
-            bool skipLock = false;
-            if (!events[i]->AutoReset) {
-                if (events[i]->State.load(std::memory_order_relaxed) &&
-                    events[i]->State.load(std::memory_order_acquire)) {
-                    skipLock = true;
+#ifdef STATS
+        bool parked = false;
+#endif
+        for (;;) {
+            if (event->AutoReset) {
+                // memory_order_acquire on success: consuming the event synchronizes with the
+                // SetEvent() call that published it.
+                if (TryConsume(event, std::memory_order_acquire)) {
+#ifdef STATS
+                    if (parked) {
+                        STAT_INC(event, WaitersWoken);
+                    }
+#endif
+                    return 0;
                 }
+            } else if (event->State.load(std::memory_order_acquire) == 1) {
+#ifdef STATS
+                if (parked) {
+                    STAT_INC(event, WaitersWoken);
+                }
+#endif
+                return 0;
             }
 
-            if (!skipLock) {
-                // Must not release lock until RegisteredWait is potentially added
-                tempResult = pthread_mutex_lock(&events[i]->Mutex);
-                assert(tempResult == 0);
+#ifdef STATS
+            // We were woken from (or bounced off) FUTEX_WAIT but didn't obtain the event: either
+            // a spurious wakeup or another thread consumed the signal first.
+            if (parked) {
+                STAT_INC(event, SpuriousWakeups);
+                parked = false;
+            }
+#endif
 
-                // Before adding this wait to the list of registered waits, let's clean up old,
-                // expired waits while we have the event lock anyway.
-                events[i]->RegisteredWaits.erase(std::remove_if(events[i]->RegisteredWaits.begin(),
-                                                                events[i]->RegisteredWaits.end(),
-                                                                RemoveExpiredWaitHelper),
-                                                 events[i]->RegisteredWaits.end());
+            // Zero-timeout event state check optimization
+            if (poll) {
+                return WAIT_TIMEOUT;
             }
 
-            if (skipLock || UnlockedWaitForEvent(events[i], 0) == 0) {
-                if (!skipLock) {
-                    tempResult = pthread_mutex_unlock(&events[i]->Mutex);
-                    assert(tempResult == 0);
+            timespec remaining;
+            timespec *timeout = nullptr;
+            if (deadline != nullptr) {
+                timespec now;
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                remaining.tv_sec = deadline->tv_sec - now.tv_sec;
+                remaining.tv_nsec = deadline->tv_nsec - now.tv_nsec;
+                if (remaining.tv_nsec < 0) {
+                    remaining.tv_nsec += 1000 * 1000 * 1000;
+                    remaining.tv_sec -= 1;
                 }
-
-                if (waitAll) {
-                    ++skipped_refs;
-                    --wfmo->Status.EventsLeft;
-                    assert(wfmo->Status.EventsLeft >= 0);
-                } else {
-                    skipped_refs += (count - i);
-                    wfmo->Status.FiredEvent = i;
-                    waitIndex = i;
-                    done = true;
-                    break;
+                if (remaining.tv_sec < 0) {
+                    return WAIT_TIMEOUT;
                 }
-            } else {
-                events[i]->RegisteredWaits.push_back(waitInfo);
-
-                tempResult = pthread_mutex_unlock(&events[i]->Mutex);
-                assert(tempResult == 0);
+                timeout = &remaining;
             }
-        }
-
-        // We set the `done` flag above in case of WaitAny and at least one event was set.
-        // But we need to check again here if we were doing a WaitAll or else we'll incorrectly
-        // return WAIT_TIMEOUT.
-        if (waitAll && wfmo->Status.EventsLeft == 0) {
-            done = true;
-        }
 
-        timespec ts;
-        if (!done) {
-            if (milliseconds == 0) {
-                result = WAIT_TIMEOUT;
-                done = true;
-            } else if (milliseconds != WAIT_INFINITE) {
-                timeval tv;
-                gettimeofday(&tv, NULL);
+            // memory_order_seq_cst: the increment must be totally ordered against the `State`
+            // exchange in SetEvent() so that either SetEvent() observes our waiter count or the
+            // kernel's atomic check of the futex word observes the new state (and fails with
+            // EAGAIN instead of parking us). A weaker ordering could lose the wakeup entirely.
+            event->Waiters.fetch_add(1, std::memory_order_seq_cst);
+            long result = futex(&event->State, FUTEX_WAIT_PRIVATE, 0, timeout);
+            event->Waiters.fetch_sub(1, std::memory_order_relaxed);
+#ifdef STATS
+            parked = true;
+#endif
 
-                uint64_t nanoseconds = ((uint64_t)tv.tv_sec) * 1000 * 1000 * 1000 +
-                                       milliseconds * 1000 * 1000 + ((uint64_t)tv.tv_usec) * 1000;
+            if (result == -1 && errno == ETIMEDOUT) {
+                return WAIT_TIMEOUT;
+            }
+            // Otherwise we were woken, interrupted (EINTR), or the state changed before we could
+            // park (EAGAIN); loop around and re-examine the state.
+        }
+    }
 
-                ts.tv_sec = (time_t) (nanoseconds / 1000 / 1000 / 1000);
-                ts.tv_nsec = (long) (nanoseconds - ((uint64_t)ts.tv_sec) * 1000 * 1000 * 1000);
+    PEVENTS_INLINE int WaitForEvent(neosmart_event_t event, uint64_t milliseconds) {
+        STAT_INC(event, Waits);
+        TRACE_PROBE2(wait_begin, event, milliseconds);
+
+        timespec deadline;
+        const timespec *until = nullptr;
+        if (milliseconds != 0 && milliseconds != WAIT_INFINITE) {
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_sec += (time_t)(milliseconds / 1000);
+            deadline.tv_nsec += (long)(milliseconds % 1000) * 1000 * 1000;
+            if (deadline.tv_nsec >= 1000 * 1000 * 1000) {
+                deadline.tv_nsec -= 1000 * 1000 * 1000;
+                deadline.tv_sec += 1;
             }
+            until = &deadline;
         }
 
-        while (!done) {
-            // One (or more) of the events we're monitoring has been triggered?
+        int result = WaitForEventCore(event, milliseconds == 0, until);
+        TRACE_PROBE2(wait_end, event, result);
+        return result;
+    }
 
-            // If we're waiting for all events, assume we're done and check if there's an event that
-            // hasn't fired But if we're waiting for just one event, assume we're not done until we
-            // find a fired event
-            done = (waitAll && wfmo->Status.EventsLeft == 0) ||
-                   (!waitAll && wfmo->Status.FiredEvent != -1);
+    PEVENTS_INLINE int WaitForEventUntil(neosmart_event_t event, const timespec &deadline) {
+        STAT_INC(event, Waits);
+        // The probe keeps the millisecond entry points' arity; WAIT_INFINITE marks a wait whose
+        // timeout is an absolute deadline rather than a relative duration
+        TRACE_PROBE2(wait_begin, event, WAIT_INFINITE);
+        int result = WaitForEventCore(event, false, &deadline);
+        TRACE_PROBE2(wait_end, event, result);
+        return result;
+    }
 
-            if (!done) {
-                if (milliseconds != WAIT_INFINITE) {
-                    result = pthread_cond_timedwait(&wfmo->CVariable, &wfmo->Mutex, &ts);
-                } else {
-                    result = pthread_cond_wait(&wfmo->CVariable, &wfmo->Mutex);
-                }
+    PEVENTS_INLINE int ReleaseEvent(neosmart_event_t event, int count) {
+        assert(event->Counted);
+        if (!event->Counted || count < 0) {
+            return EINVAL;
+        }
+        if (count == 0) {
+            return 0;
+        }
 
-                if (result != 0) {
-                    break;
-                }
+        // memory_order_seq_cst: see the ordering comment in WaitForEvent(). Unlike a plain
+        // SetEvent(), a nonzero prior count doesn't let us skip the wake: earlier releases only
+        // woke as many waiters as they added units, so additional waiters may still be parked.
+        int prior = event->State.fetch_add(count, std::memory_order_seq_cst);
+        if (event->Waiters.load(std::memory_order_seq_cst) > 0) {
+            futex(&event->State, FUTEX_WAKE_PRIVATE, count, nullptr);
+        }
+        if (prior == 0) {
+            int fd = event->BridgeFd.load(std::memory_order_relaxed);
+            if (fd != -1) {
+                SignalBridgeFd(fd);
             }
         }
+        return 0;
+    }
 
-        waitIndex = wfmo->Status.FiredEvent;
-        // memory_order_relaxed: this is only checked outside the mutex to determine if waiting has
-        // terminated meaning it's safe to decrement the ref count. If it's true (which we write
-        // with release semantics), then the mutex is always entered.
-        wfmo->StillWaiting.store(false, std::memory_order_relaxed);
-
-        tempResult = pthread_mutex_unlock(&wfmo->Mutex);
-        assert(tempResult == 0);
-
-        // memory_order_seq_cst: Ensure this is run after the wfmo mutex is unlocked
-        int ref_count = wfmo->RefCount.fetch_sub(1 + skipped_refs, std::memory_order_seq_cst);
-        assert(ref_count > 0);
-        if (ref_count == 1 + skipped_refs) {
-            wfmo->Destroy();
-            delete wfmo;
+    PEVENTS_INLINE int SetEvent(neosmart_event_t event) {
+        TRACE_PROBE1(set, event);
+        if (event->Counted) {
+            // A plain SetEvent() on a counted event releases a single unit
+            return ReleaseEvent(event, 1);
         }
 
-        return result;
+        // memory_order_seq_cst: see the ordering comment in WaitForEvent(). If the event was
+        // already signaled, any parked waiter is guaranteed a wake from the exchange that first
+        // signaled it, so we can skip the syscall.
+        if (event->State.exchange(1, std::memory_order_seq_cst) == 0) {
+            if (event->Waiters.load(std::memory_order_seq_cst) > 0) {
+                futex(&event->State, FUTEX_WAKE_PRIVATE, event->AutoReset ? 1 : INT_MAX, nullptr);
+            }
+            int fd = event->BridgeFd.load(std::memory_order_relaxed);
+            if (fd != -1) {
+                SignalBridgeFd(fd);
+            }
+        }
+        return 0;
     }
-#endif // WFMO
 
-    int DestroyEvent(neosmart_event_t event) {
+    PEVENTS_INLINE int SetEvents(neosmart_event_t *events, int count) {
+        // There is no lock acquisition to amortize here: each signal is already just an atomic
+        // exchange plus (at most) one FUTEX_WAKE syscall.
+        for (int i = 0; i < count; ++i) {
+            int result = SetEvent(events[i]);
+            assert(result == 0);
+            (void)result;
+        }
+        return 0;
+    }
+
+    PEVENTS_INLINE int ResetEvent(neosmart_event_t event) {
+        // memory_order_relaxed and no stronger ordering: there can't be any guarantees about
+        // concurrent calls to either of WaitForEvent()/SetEvent() and ResetEvent() because
+        // they're racy by nature.
+        event->State.store(0, std::memory_order_relaxed);
+        DrainBridge(event);
+        return 0;
+    }
+
+    PEVENTS_INLINE int DestroyEvent(neosmart_event_t event) {
+        int fd = event->BridgeFd.load(std::memory_order_relaxed);
+        if (fd != -1) {
+            close(fd);
+        }
+        delete event;
+        return 0;
+    }
+
+    // On this backend creation is a bare allocation plus a few stores — there is no pthread
+    // init/teardown to amortize — so the caching entry points just forward, keeping code
+    // portable across backends.
+    PEVENTS_INLINE neosmart_event_t CreateEventCached(bool manualReset, bool initialState,
+                                                      bool spinWait) {
+        return CreateEvent(manualReset, initialState, spinWait);
+    }
+
+    PEVENTS_INLINE int RecycleEvent(neosmart_event_t event) {
+        return DestroyEvent(event);
+    }
+
+    PEVENTS_INLINE int GetEventFd(neosmart_event_t event) {
+        int fd = event->BridgeFd.load(std::memory_order_acquire);
+        if (fd != -1) {
+            return fd;
+        }
+
+        int writeFd;
+        fd = CreateBridgeFd(writeFd);
+        if (fd == -1) {
+            return -1;
+        }
+
+        int expected = -1;
+        if (!event->BridgeFd.compare_exchange_strong(expected, fd, std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+            // Another thread attached a bridge first; use theirs
+            close(fd);
+            return expected;
+        }
+
+        // Catch up with a state that was signaled before the bridge existed. A SetEvent() racing
+        // with us may also see the fd and signal it; a double-signaled eventfd still reads (and
+        // drains) as a single readable edge. Any nonzero state means signaled: counted events
+        // store their pending count in the futex word.
+        if (event->State.load(std::memory_order_acquire) > 0) {
+            SignalBridgeFd(fd);
+        }
+
+        return fd;
+    }
+
+    // A cross-process event placement-constructed into caller-provided shared memory. The same
+    // futex-word protocol as neosmart_event_t_, minus the process-local amenities (spin budget,
+    // counted mode, bridge fd, stats): the kernel keys non-PRIVATE futex operations by the
+    // backing page, so waiters and signalers in different processes rendezvous on the one word.
+    // The magic value is backend-specific on purpose — a pthread-backed build must not attach to
+    // a futex-backed event (the layouts share nothing).
+    static const uint32_t EventSharedMagic = 0x70457646; // "FvEp"
+
+    struct neosmart_event_shared_t_ {
+        std::atomic<int> State;
+        std::atomic<int> Waiters;
+        bool AutoReset;
+        // Written last (release) by CreateEventShared() so OpenEventShared() in another process
+        // can't observe a half-constructed event.
+        std::atomic<uint32_t> Magic;
+    };
+
+    PEVENTS_INLINE size_t EventSharedSize() {
+        return sizeof(neosmart_event_shared_t_);
+    }
+
+    PEVENTS_INLINE neosmart_event_shared_t CreateEventShared(void *region, bool manualReset,
+                                                             bool initialState) {
+        neosmart_event_shared_t event = new (region) neosmart_event_shared_t_;
+
+        event->AutoReset = !manualReset;
+        event->Waiters.store(0, std::memory_order_relaxed);
+        event->State.store(initialState ? 1 : 0, std::memory_order_relaxed);
+        event->Magic.store(EventSharedMagic, std::memory_order_release);
+
+        return event;
+    }
+
+    PEVENTS_INLINE neosmart_event_shared_t OpenEventShared(void *region) {
+        neosmart_event_shared_t event = static_cast<neosmart_event_shared_t>(region);
+        // memory_order_acquire: pairs with the publishing store in CreateEventShared()
+        if (event->Magic.load(std::memory_order_acquire) != EventSharedMagic) {
+            return nullptr;
+        }
+        return event;
+    }
+
+    PEVENTS_INLINE int WaitForEventShared(neosmart_event_shared_t event, uint64_t milliseconds) {
+        timespec deadline;
+        if (milliseconds != 0 && milliseconds != WAIT_INFINITE) {
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_sec += (time_t)(milliseconds / 1000);
+            deadline.tv_nsec += (long)(milliseconds % 1000) * 1000 * 1000;
+            if (deadline.tv_nsec >= 1000 * 1000 * 1000) {
+                deadline.tv_nsec -= 1000 * 1000 * 1000;
+                deadline.tv_sec += 1;
+            }
+        }
+
+        for (;;) {
+            if (event->AutoReset) {
+                // memory_order_acquire on success: consuming the event synchronizes with the
+                // SetEventShared() call (in whichever process) that published it.
+                int expected = 1;
+                if (event->State.compare_exchange_strong(expected, 0, std::memory_order_acquire,
+                                                         std::memory_order_relaxed)) {
+                    return 0;
+                }
+            } else if (event->State.load(std::memory_order_acquire) == 1) {
+                return 0;
+            }
+
+            if (milliseconds == 0) {
+                return WAIT_TIMEOUT;
+            }
+
+            timespec remaining;
+            timespec *timeout = nullptr;
+            if (milliseconds != WAIT_INFINITE) {
+                timespec now;
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                remaining.tv_sec = deadline.tv_sec - now.tv_sec;
+                remaining.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+                if (remaining.tv_nsec < 0) {
+                    remaining.tv_nsec += 1000 * 1000 * 1000;
+                    remaining.tv_sec -= 1;
+                }
+                if (remaining.tv_sec < 0) {
+                    return WAIT_TIMEOUT;
+                }
+                timeout = &remaining;
+            }
+
+            // memory_order_seq_cst: see the ordering comment in WaitForEvent(). FUTEX_WAIT (not
+            // _PRIVATE) so the kernel matches waiters across process boundaries.
+            event->Waiters.fetch_add(1, std::memory_order_seq_cst);
+            long result = futex(&event->State, FUTEX_WAIT, 0, timeout);
+            event->Waiters.fetch_sub(1, std::memory_order_relaxed);
+
+            if (result == -1 && errno == ETIMEDOUT) {
+                return WAIT_TIMEOUT;
+            }
+        }
+    }
+
+    PEVENTS_INLINE int SetEventShared(neosmart_event_shared_t event) {
+        // memory_order_seq_cst: see the ordering comment in WaitForEvent()
+        if (event->State.exchange(1, std::memory_order_seq_cst) == 0) {
+            if (event->Waiters.load(std::memory_order_seq_cst) > 0) {
+                futex(&event->State, FUTEX_WAKE, event->AutoReset ? 1 : INT_MAX, nullptr);
+            }
+        }
+        return 0;
+    }
+
+    PEVENTS_INLINE int ResetEventShared(neosmart_event_shared_t event) {
+        // Racy by nature against concurrent signals/waits, exactly like ResetEvent()
+        event->State.store(0, std::memory_order_relaxed);
+        return 0;
+    }
+
+    PEVENTS_INLINE int DestroyEventShared(neosmart_event_shared_t event) {
+        // Nothing kernel-side to tear down; just spoil the magic so a stale OpenEventShared()
+        // against the recycled region fails. Freeing (or unmapping) the region is the caller's.
+        event->Magic.store(0, std::memory_order_relaxed);
+        return 0;
+    }
+
+#ifdef STATS
+    PEVENTS_INLINE int GetEventStats(neosmart_event_t event, neosmart_event_stats_t &stats) {
+        stats.Waits = event->Stats.Waits.load(std::memory_order_relaxed);
+        stats.LockWaits = event->Stats.LockWaits.load(std::memory_order_relaxed);
+        stats.SpuriousWakeups = event->Stats.SpuriousWakeups.load(std::memory_order_relaxed);
+        stats.WaitersWoken = event->Stats.WaitersWoken.load(std::memory_order_relaxed);
+        stats.ExpiredWaits = event->Stats.ExpiredWaits.load(std::memory_order_relaxed);
+        return 0;
+    }
+#endif
+} // namespace neosmart
+#else // !FUTEX
+
+namespace neosmart {
+    // Initialize a condition variable for monotonic-clock timed waits, so that deadlines are
+    // immune to wall-clock (NTP) adjustments. Apple platforms lack pthread_condattr_setclock();
+    // there we leave the condvar on the default clock and wait with relative timeouts instead
+    // (see TimedWait()).
+    static int InitCondVariable(pthread_cond_t *cv) {
+#ifdef __APPLE__
+        return pthread_cond_init(cv, 0);
+#else
+        pthread_condattr_t attr;
+        int result = pthread_condattr_init(&attr);
+        assert(result == 0);
+        result = pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        assert(result == 0);
+        result = pthread_cond_init(cv, &attr);
+        pthread_condattr_destroy(&attr);
+        return result;
+#endif
+    }
+
+    // Compute the absolute CLOCK_MONOTONIC deadline `milliseconds` from now: one vDSO-backed
+    // clock_gettime() call and no division, where the previous gettimeofday() arithmetic paid a
+    // syscall and a 64-bit multiply/divide chain on every timed wait.
+    static void DeadlineFromNow(uint64_t milliseconds, timespec &deadline) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += (time_t)(milliseconds / 1000);
+        deadline.tv_nsec += (long)(milliseconds % 1000) * 1000 * 1000;
+        if (deadline.tv_nsec >= 1000 * 1000 * 1000) {
+            deadline.tv_nsec -= 1000 * 1000 * 1000;
+            deadline.tv_sec += 1;
+        }
+    }
+
+    // Block on the condition variable until signaled or the CLOCK_MONOTONIC deadline passes.
+    static int TimedWait(pthread_cond_t *cv, pthread_mutex_t *mutex, const timespec &deadline) {
+#ifdef __APPLE__
+        // No monotonic condvar clock here; re-derive the remaining time on every call so that
+        // spurious wakeups in the caller's re-wait loop can't stretch the overall deadline.
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        timespec remaining;
+        remaining.tv_sec = deadline.tv_sec - now.tv_sec;
+        remaining.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+        if (remaining.tv_nsec < 0) {
+            remaining.tv_nsec += 1000 * 1000 * 1000;
+            remaining.tv_sec -= 1;
+        }
+        if (remaining.tv_sec < 0) {
+            return ETIMEDOUT;
+        }
+        return pthread_cond_timedwait_relative_np(cv, mutex, &remaining);
+#else
+        return pthread_cond_timedwait(cv, mutex, &deadline);
+#endif
+    }
+
+#ifdef WFMO
+    struct neosmart_wfmo_t_;
+    typedef neosmart_wfmo_t_ *neosmart_wfmo_t;
+
+    // A neosmart_wfmo_info_t object is registered with each event waited on in a WFMO. It doubles
+    // as an intrusive doubly-linked list node in that event's list of registered waits; the node
+    // itself lives inside the waiter's wfmo allocation (see neosmart_wfmo_t_::Waits()), so
+    // registration allocates nothing and unlinking on wake is O(1).
+    // This reference to neosmart_wfmo_t_ is how the event knows whom to notify when triggered
+    struct neosmart_wfmo_info_t_ {
+        neosmart_wfmo_t Waiter;
+        int WaitIndex;
+        // The wait's wakeup priority: an event's list is kept ordered by descending priority
+        // (FIFO within a priority), so the head — the node an auto-reset signal is handed to —
+        // is always the highest-priority registered waiter. Zero for waits that don't opt in.
+        int Priority;
+        neosmart_wfmo_info_t_ *Prev;
+        neosmart_wfmo_info_t_ *Next;
+        // A persistent node belongs to a wait-set: it stays linked across waits (events never
+        // unlink it, even when its waiter isn't currently waiting) and is only removed by
+        // DestroyWaitSet(). Protected by the owning event's mutex, like the links themselves.
+        bool Persistent;
+        // Whether this event has already been delivered to the current wait of a wait-set, used
+        // to preserve the one-delivery-per-event-per-wait behavior that transient waits get by
+        // virtue of unlinking on delivery. Protected by the waiter's (wfmo) mutex.
+        bool Accounted;
+    };
+    typedef neosmart_wfmo_info_t_ *neosmart_wfmo_info_t;
+
+    // Each call to WaitForMultipleObjects initializes a neosmart_wfmo_t object which tracks
+    // the progress of the caller's multi-object wait and dispatches responses accordingly.
+    // One neosmart_wfmo_t struct is shared for all events in a single WFMO call
+    struct neosmart_wfmo_t_ {
+        pthread_mutex_t Mutex;
+        pthread_cond_t CVariable;
+        std::atomic<int> RefCount;
+        union {
+            int FiredEvent; // WFSO
+            int EventsLeft; // WFMO
+        } Status;
+        bool WaitAll;
+        std::atomic<bool> StillWaiting;
+        // The number of registration nodes in the trailing array (see AcquireWfmo)
+        int Capacity;
+
+        void Destroy() {
+            pthread_mutex_destroy(&Mutex);
+            pthread_cond_destroy(&CVariable);
+        }
+
+        // The per-event registration nodes for this wait live directly after the struct in the
+        // same allocation, one per waited event, so the whole wait needs exactly one allocation
+        neosmart_wfmo_info_t Waits() {
+            return reinterpret_cast<neosmart_wfmo_info_t>(this + 1);
+        }
+    };
+
+    // A per-thread cache of fully-initialized neosmart_wfmo_t_ objects (mutex and condvar already
+    // initialized) so the WFMO hot path doesn't touch the heap allocator or pay pthread init
+    // costs for each call. The cache is thread-local to avoid any synchronization of its own;
+    // since the last reference to a wfmo may be dropped by a SetEvent() call on another thread,
+    // objects can migrate between caches, so each cache is bounded and overflow is freed outright.
+    struct neosmart_wfmo_pool_t_ {
+        static const size_t MaxSize = 16;
+        neosmart_wfmo_t Cache[MaxSize];
+        size_t Size = 0;
+
+        ~neosmart_wfmo_pool_t_();
+    };
+    static thread_local neosmart_wfmo_pool_t_ WfmoPool;
+
+    static void DestroyWfmo(neosmart_wfmo_t wfmo) {
+        wfmo->Destroy();
+        wfmo->~neosmart_wfmo_t_();
+        ::operator delete(static_cast<void *>(wfmo));
+    }
+
+    neosmart_wfmo_pool_t_::~neosmart_wfmo_pool_t_() {
+        while (Size > 0) {
+            DestroyWfmo(Cache[--Size]);
+        }
+    }
+
+    // Obtain a neosmart_wfmo_t_ with its mutex and condvar ready for use and room for at least
+    // `count` registration nodes; the caller need only initialize `Status`, `WaitAll`,
+    // `StillWaiting`, and `RefCount`. Capacities are rounded up to powers of two so that cached
+    // objects are reusable across waits of similar (not just identical) widths.
+    static neosmart_wfmo_t AcquireWfmo(int count) {
+        if (WfmoPool.Size > 0) {
+            neosmart_wfmo_t wfmo = WfmoPool.Cache[WfmoPool.Size - 1];
+            if (wfmo->Capacity >= count) {
+                --WfmoPool.Size;
+                return wfmo;
+            }
+            // Too small for this wait; retire it so the cache trends towards the widest waits in
+            // active use.
+            --WfmoPool.Size;
+            DestroyWfmo(wfmo);
+        }
+
+        int capacity = 4;
+        while (capacity < count) {
+            capacity *= 2;
+        }
+
+        void *memory =
+            ::operator new(sizeof(neosmart_wfmo_t_) + capacity * sizeof(neosmart_wfmo_info_t_));
+        neosmart_wfmo_t wfmo = new (memory) neosmart_wfmo_t_;
+        wfmo->Capacity = capacity;
+
+        int result = pthread_mutex_init(&wfmo->Mutex, 0);
+        assert(result == 0);
+
+        result = InitCondVariable(&wfmo->CVariable);
+        assert(result == 0);
+        (void)result;
+
+        return wfmo;
+    }
+
+    // Return a dead (RefCount == 0) wfmo to the current thread's cache, keeping its mutex and
+    // condvar initialized for reuse.
+    static void ReleaseWfmo(neosmart_wfmo_t wfmo) {
+        if (WfmoPool.Size < neosmart_wfmo_pool_t_::MaxSize) {
+            WfmoPool.Cache[WfmoPool.Size++] = wfmo;
+            return;
+        }
+
+        DestroyWfmo(wfmo);
+    }
+#endif // WFMO
+
+    // The basic event structure, passed to the caller as an opaque pointer when creating events
+    struct neosmart_event_t_ {
+        pthread_cond_t CVariable;
+        pthread_mutex_t Mutex;
+        bool AutoReset;
+        // Whether waits against this event spin before blocking; see the spin budget discussion
+        // above.
+        bool SpinWait;
+        // A counted (semaphore-style) event carries its pending signal count in `Count` instead
+        // of the boolean `State`, which stays false; see CreateCountedEvent().
+        bool Counted;
+        std::atomic<uint32_t> SpinBudget;
+        std::atomic<bool> State;
+        std::atomic<int> Count;
+#ifdef WFMO
+        // Intrusive doubly-linked list of registered WFMO waits, in registration order. The
+        // nodes live inside each waiter's wfmo allocation; a linked node holds one reference to
+        // its waiter, dropped when the node is unlinked.
+        neosmart_wfmo_info_t WaitsHead;
+        neosmart_wfmo_info_t WaitsTail;
+        // How many of the linked nodes are persistent (wait-set) registrations; when zero, a
+        // manual-reset broadcast may detach the whole list instead of walking it in-lock.
+        // Protected by the event mutex.
+        int PersistentWaits;
+        // Completion-port association: when set, every signal against this (auto-reset) event is
+        // converted into a queued completion on the port instead of being stored in the event.
+        // Protected by the event mutex. See AssociateEvent().
+        neosmart_port_t Port;
+        uintptr_t PortKey;
+        // Packed-readiness hook for grouped events: when non-null, the event mirrors its
+        // signaled state into `ReadyMask` of the shared word the pointer addresses, so a group
+        // wait can scan whole 64-event words instead of touching each event. Null (and the
+        // mirroring branch dead-predictable) for ungrouped events. See CreateEventGroup().
+        std::atomic<uint64_t> *ReadyWord;
+        uint64_t ReadyMask;
+#endif
+#ifdef CORO
+        // Intrusive singly-linked list of registered awaiters, in registration order. The nodes
+        // live in the awaiting coroutines' frames; see RegisterAwait().
+        neosmart_await_t_ *AwaitsHead;
+        neosmart_await_t_ *AwaitsTail;
+#endif
+#ifdef PULSE
+        // Pulse bookkeeping, protected by the event mutex: a pulse is delivered only to threads
+        // that were already blocked when it fired and is never published in `State`. The
+        // generation advances with every pulse; a blocked waiter that captured an older
+        // generation may take the pulse, consuming the single token for auto-reset events.
+        uint32_t PulseGeneration;
+        int PulseTokens;
+#endif
+        // Lazily-created pollable fd mirroring the signaled state; -1 until GetEventFd(). The
+        // write end only differs from BridgeFd on the self-pipe fallback (see CreateBridgeFd()).
+        std::atomic<int> BridgeFd;
+        int BridgeWriteFd;
+        // Link for the event cache's global overflow list (see RecycleEvent()); only touched
+        // while the event is parked there.
+        neosmart_event_t_ *FreeNext;
+#ifdef STATS
+        neosmart_event_stats_internal_t_ Stats;
+#endif
+    };
+
+    // Arena slot size for CreateEventArray(): the event padded out to whole cache lines
+    static inline size_t EventArrayStride() {
+        return (sizeof(neosmart_event_t_) + EventCacheLineSize - 1) & ~(EventCacheLineSize - 1);
+    }
+
+    // Drain the bridge fd (if one has been attached) after consuming an auto-reset signal or
+    // resetting the event, so the fd stops polling as readable.
+    static inline void DrainBridge(neosmart_event_t event) {
+        int fd = event->BridgeFd.load(std::memory_order_relaxed);
+        if (fd != -1) {
+            DrainBridgeFd(fd);
+        }
+    }
+
+#ifdef HYBRID
+    // Attempt budget for the hybrid event-lock acquisition. Every critical section guarded by
+    // an event mutex is a handful of instructions — flipping the state, linking or unlinking a
+    // registration — so a contended acquisition is overwhelmingly likely to succeed within a
+    // short spin, and parking in the kernel (plus the convoy that forms behind a lock held for
+    // nanoseconds) is the real slow path. The budget is deliberately small and fixed: unlike
+    // the per-event wait spin, whose profitable window varies with signal latency, the hold
+    // time here is a property of the library itself.
+    static const uint32_t LockSpinLimit = 64;
+#endif
+
+    // Lock the event mutex, counting acquisitions that couldn't be satisfied without blocking
+    // when statistics are enabled. With HYBRID, contended acquisitions spin briefly — the
+    // trylock doubles as the test-and-set, with an exponentially-growing stretch of pause
+    // instructions between attempts keeping the cache line mostly shared — before falling back
+    // to the blocking lock. The lock stays a pthread mutex underneath so the event condition
+    // variables work unchanged; only the acquisition strategy differs.
+    static int LockEventMutex(neosmart_event_t event) {
+#ifdef HYBRID
+        uint32_t backoff = 1;
+        for (uint32_t spin = 0; spin < LockSpinLimit; ++spin) {
+            int result = pthread_mutex_trylock(&event->Mutex);
+            if (result != EBUSY) {
+                return result;
+            }
+            for (uint32_t pause = 0; pause < backoff; ++pause) {
+                SpinPause();
+            }
+            if (backoff < 32) {
+                backoff *= 2;
+            }
+        }
+        // The spin window closed without the lock changing hands; this is genuine (or
+        // long-held) contention, so block like the plain path would
+        STAT_INC(event, LockWaits);
+        return pthread_mutex_lock(&event->Mutex);
+#else
+#ifdef STATS
+        int result = pthread_mutex_trylock(&event->Mutex);
+        if (result != EBUSY) {
+            return result;
+        }
+        STAT_INC(event, LockWaits);
+#endif
+        return pthread_mutex_lock(&event->Mutex);
+#endif // HYBRID
+    }
+
+#ifdef WFMO
+    // All list manipulation requires the event mutex to be held.
+    // Insert preserving descending priority order with FIFO among equals: a node goes after
+    // every node of equal or higher priority. The common case — everything at the default
+    // priority — is a plain O(1) tail append; only a wait that actually outranks the tail pays
+    // for the ordered walk.
+    static void AppendWait(neosmart_event_t event, neosmart_wfmo_info_t node) {
+        if (event->WaitsTail == nullptr || event->WaitsTail->Priority >= node->Priority) {
+            node->Prev = event->WaitsTail;
+            node->Next = nullptr;
+            if (event->WaitsTail != nullptr) {
+                event->WaitsTail->Next = node;
+            } else {
+                event->WaitsHead = node;
+            }
+            event->WaitsTail = node;
+            return;
+        }
+
+        // The tail is outranked, so some node with lower priority exists: insert before the
+        // first such node.
+        neosmart_wfmo_info_t after = event->WaitsHead;
+        while (after->Priority >= node->Priority) {
+            after = after->Next;
+        }
+        node->Prev = after->Prev;
+        node->Next = after;
+        if (after->Prev != nullptr) {
+            after->Prev->Next = node;
+        } else {
+            event->WaitsHead = node;
+        }
+        after->Prev = node;
+    }
+
+    static void UnlinkWait(neosmart_event_t event, neosmart_wfmo_info_t node) {
+        if (node->Prev != nullptr) {
+            node->Prev->Next = node->Next;
+        } else {
+            event->WaitsHead = node->Next;
+        }
+        if (node->Next != nullptr) {
+            node->Next->Prev = node->Prev;
+        } else {
+            event->WaitsTail = node->Prev;
+        }
+        node->Prev = nullptr;
+        node->Next = nullptr;
+    }
+
+    // Unlink any waits whose waiter has already abandoned the wait, dropping the reference the
+    // list held on each. A node must always be unlinked *before* its reference is dropped, or
+    // another thread could free the wfmo (and with it the node) while it is still linked.
+    static void PruneExpiredWaits(neosmart_event_t event) {
+        for (neosmart_wfmo_info_t node = event->WaitsHead; node != nullptr;) {
+            neosmart_wfmo_info_t next = node->Next;
+            if (!node->Persistent && !node->Waiter->StillWaiting.load(std::memory_order_relaxed)) {
+                UnlinkWait(event, node);
+                STAT_INC(event, ExpiredWaits);
+
+                int ref_count = node->Waiter->RefCount.fetch_sub(1, std::memory_order_acq_rel);
+                assert(ref_count > 0);
+                if (ref_count == 1) {
+                    ReleaseWfmo(node->Waiter);
+                }
+            }
+            node = next;
+        }
+    }
+#endif // WFMO
+
+    // Shared initialization for individually-allocated and arena-constructed events
+    static void InitializeEvent(neosmart_event_t event, bool manualReset, bool initialState,
+                                bool spinWait) {
+        int result = InitCondVariable(&event->CVariable);
+        assert(result == 0);
+
+        result = pthread_mutex_init(&event->Mutex, 0);
+        assert(result == 0);
+        (void)result;
+
+        event->AutoReset = !manualReset;
+        event->SpinWait = spinWait;
+        event->Counted = false;
+        event->Count.store(0, std::memory_order_relaxed);
+        event->SpinBudget.store(SpinBudgetDefault, std::memory_order_relaxed);
+#ifdef WFMO
+        event->WaitsHead = nullptr;
+        event->WaitsTail = nullptr;
+        event->PersistentWaits = 0;
+        event->Port = nullptr;
+        event->PortKey = 0;
+        event->ReadyWord = nullptr;
+        event->ReadyMask = 0;
+#endif
+#ifdef CORO
+        event->AwaitsHead = nullptr;
+        event->AwaitsTail = nullptr;
+#endif
+#ifdef PULSE
+        event->PulseGeneration = 0;
+        event->PulseTokens = 0;
+#endif
+        event->BridgeFd.store(-1, std::memory_order_relaxed);
+        event->BridgeWriteFd = -1;
+#ifdef STATS
+        event->Stats.Waits.store(0, std::memory_order_relaxed);
+        event->Stats.LockWaits.store(0, std::memory_order_relaxed);
+        event->Stats.SpuriousWakeups.store(0, std::memory_order_relaxed);
+        event->Stats.WaitersWoken.store(0, std::memory_order_relaxed);
+        event->Stats.ExpiredWaits.store(0, std::memory_order_relaxed);
+#endif
+        // memory_order_release: if `initialState == true`, allow a load with acquire semantics to
+        // see the value.
+        event->State.store(initialState, std::memory_order_release);
+    }
+
+    PEVENTS_INLINE neosmart_event_t CreateEvent(bool manualReset, bool initialState, bool spinWait) {
+        neosmart_event_t event = new neosmart_event_t_;
+        InitializeEvent(event, manualReset, initialState, spinWait);
+        return event;
+    }
+
+    PEVENTS_INLINE neosmart_event_t CreateCountedEvent(int initialCount, bool spinWait) {
+        assert(initialCount >= 0);
+
+        neosmart_event_t event = CreateEvent(false, false, spinWait);
+        event->Counted = true;
+        // memory_order_release: like the initial `State` store above
+        event->Count.store(initialCount, std::memory_order_release);
+
+        return event;
+    }
+
+#ifdef WFMO
+    // Mirror the event's signaled state into its group's packed readiness bitmap. The bits are
+    // a relaxed hint, never a synchronization point: a stale-one bit costs a probe (every
+    // apparent signal is confirmed — and consumed — with the usual lock-free claim) and a
+    // stale-zero bit costs a fallback to the authoritative per-event scan, never correctness.
+    static inline void SetReadyBit(neosmart_event_t event) {
+        if (event->ReadyWord != nullptr) {
+            event->ReadyWord->fetch_or(event->ReadyMask, std::memory_order_relaxed);
+        }
+    }
+
+    static inline void ClearReadyBit(neosmart_event_t event) {
+        if (event->ReadyWord != nullptr) {
+            event->ReadyWord->fetch_and(~event->ReadyMask, std::memory_order_relaxed);
+            // Heal the bit if the event was concurrently re-signaled: SetEvent() only sets the
+            // bit on an unsignaled-to-signaled transition, so a clear that lands after a
+            // re-signal's set in the word's modification order would otherwise leave the bit
+            // stale-zero until the event is next consumed.
+            if (event->State.load(std::memory_order_relaxed)) {
+                event->ReadyWord->fetch_or(event->ReadyMask, std::memory_order_relaxed);
+            }
+        }
+    }
+#endif // WFMO
+
+    // Relaxed "does this event look signaled" check for the lock-skipping fast paths; stale
+    // answers are fine, they just cost a fallback to the locked path.
+    static inline bool LooksSignaled(neosmart_event_t event) {
+        if (event->Counted) {
+            return event->Count.load(std::memory_order_relaxed) > 0;
+        }
+        return event->State.load(std::memory_order_relaxed);
+    }
+
+    // Attempt to obtain the event without blocking, assuming it is currently signaled. Auto-reset
+    // events are consumed with an atomic exchange rather than a load-then-store: spin-wait events
+    // may be consumed by a spinning thread that does not hold the event mutex, and the exchange
+    // guarantees that exactly one contender obtains each signal. Counted events likewise consume
+    // one unit of the count with a CAS so lock-free contenders can't double-consume.
+    static bool TryObtainEvent(neosmart_event_t event, std::memory_order order) {
+        if (event->Counted) {
+            int count = event->Count.load(std::memory_order_relaxed);
+            while (count > 0) {
+                if (event->Count.compare_exchange_weak(count, count - 1, order,
+                                                       std::memory_order_relaxed)) {
+                    if (count == 1) {
+                        DrainBridge(event);
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (event->AutoReset) {
+            if (event->State.exchange(false, order)) {
+#ifdef WFMO
+                ClearReadyBit(event);
+#endif
+                DrainBridge(event);
+                return true;
+            }
+            return false;
+        }
+        return event->State.load(order);
+    }
+
+#ifdef CORO
+    // Awaiter list manipulation requires the event mutex to be held.
+    static neosmart_await_t_ *PopAwait(neosmart_event_t event) {
+        neosmart_await_t_ *await = event->AwaitsHead;
+        event->AwaitsHead = await->Next;
+        if (event->AwaitsHead == nullptr) {
+            event->AwaitsTail = nullptr;
+        }
+        return await;
+    }
+
+    static neosmart_await_t_ *DetachAwaits(neosmart_event_t event) {
+        neosmart_await_t_ *head = event->AwaitsHead;
+        event->AwaitsHead = nullptr;
+        event->AwaitsTail = nullptr;
+        return head;
+    }
+
+    // Resume a detached chain of awaiters, with no event locks held: a resumed continuation may
+    // immediately re-await (or destroy) the event. Each link must be read before its callback
+    // runs because the coroutine frame holding the node may be destroyed by the resumption.
+    static void ResumeAwaits(neosmart_await_t_ *head) {
+        for (neosmart_await_t_ *await = head, *next = nullptr; await != nullptr; await = next) {
+            next = await->Next;
+            await->Resume(await->Context);
+        }
+    }
+
+    PEVENTS_INLINE int RegisterAwait(neosmart_event_t event, neosmart_await_t_ *await) {
+        int result = LockEventMutex(event);
+        assert(result == 0);
+
+        // memory_order_relaxed: see the UnlockedWaitForEvent() rationale — the pending state is
+        // only published under the event mutex, and the auto-reset/counted consume is an atomic
+        // RMW that arbitrates against lock-free spinners regardless.
+        if (TryObtainEvent(event, std::memory_order_relaxed)) {
+            result = pthread_mutex_unlock(&event->Mutex);
+            assert(result == 0);
+            (void)result;
+            return 1;
+        }
+
+        await->Next = nullptr;
+        if (event->AwaitsTail != nullptr) {
+            event->AwaitsTail->Next = await;
+        } else {
+            event->AwaitsHead = await;
+        }
+        event->AwaitsTail = await;
+
+        result = pthread_mutex_unlock(&event->Mutex);
+        assert(result == 0);
+        (void)result;
+        return 0;
+    }
+#endif // CORO
+
+    // The blocking core of a single-event wait against an absolute CLOCK_MONOTONIC deadline
+    // (null: wait forever), factored out so deadline-based callers can pass their own timespec
+    // straight through without a clock read or a round trip via milliseconds. The event mutex
+    // must be held.
+    static int UnlockedWaitForEventUntil(neosmart_event_t event, const timespec *deadline) {
+        int result = 0;
+        // memory_order_relaxed for manual-reset events: `State` is only set to true with the mutex
+        // held, and we require that this function only be called after the mutex is obtained. The
+        // auto-reset consume inside TryObtainEvent() is an exchange so it can also arbitrate
+        // against lock-free spinners; see above.
+        if (!TryObtainEvent(event, std::memory_order_relaxed)) {
+#ifdef PULSE
+            // Captured under the mutex before blocking: only a pulse that fires while we're
+            // blocked (advancing the generation) may be taken below.
+            uint32_t generation = event->PulseGeneration;
+#endif
+            for (;;) {
+                // Regardless of whether it's an auto-reset or manual-reset event:
+                // wait to obtain the event, then lock anyone else out
+                if (deadline != nullptr) {
+                    result = TimedWait(&event->CVariable, &event->Mutex, *deadline);
+                } else {
+                    result = pthread_cond_wait(&event->CVariable, &event->Mutex);
+                }
+                if (result != 0) {
+                    break;
+                }
+                // memory_order_relaxed: ordering is guaranteed by the mutex, as `State = true` is
+                // only ever written with the mutex held. For auto-reset events, the exchange also
+                // stops anyone else from using the event the moment we've obtained it.
+                if (TryObtainEvent(event, std::memory_order_relaxed)) {
+                    STAT_INC(event, WaitersWoken);
+                    break;
+                }
+#ifdef PULSE
+                // A pulse that fired after we blocked satisfies the wait: a manual-reset pulse
+                // releases every such waiter, an auto-reset pulse carries a single token.
+                if (event->PulseGeneration != generation &&
+                    (!event->AutoReset || event->PulseTokens > 0)) {
+                    if (event->AutoReset) {
+                        --event->PulseTokens;
+                    }
+                    STAT_INC(event, WaitersWoken);
+                    break;
+                }
+#endif
+                // Woken without the event being obtainable: a spurious wakeup, or another thread
+                // consumed the signal first.
+                STAT_INC(event, SpuriousWakeups);
+            }
+        } else {
+            // We obtained the event: either it was an available auto-reset event (now consumed by
+            // the exchange, locking anyone else out) or a manual reset event with a signaled
+            // state (in which case there's nothing else to do).
+        }
+
+        return result;
+    }
+
+    static int UnlockedWaitForEvent(neosmart_event_t event, uint64_t milliseconds) {
+        // See the memory ordering rationale in UnlockedWaitForEventUntil(); trying here first
+        // keeps the clock unread for waits satisfied immediately and for zero-timeout polls.
+        if (TryObtainEvent(event, std::memory_order_relaxed)) {
+            return 0;
+        }
+        // Zero-timeout event state check optimization
+        if (milliseconds == 0) {
+            return WAIT_TIMEOUT;
+        }
+        if (milliseconds == WAIT_INFINITE) {
+            return UnlockedWaitForEventUntil(event, nullptr);
+        }
+
+        timespec deadline;
+        DeadlineFromNow(milliseconds, deadline);
+        return UnlockedWaitForEventUntil(event, &deadline);
+    }
+
+    PEVENTS_INLINE int WaitForEventUntil(neosmart_event_t event, const timespec &deadline) {
+        STAT_INC(event, Waits);
+        // The probe keeps the millisecond entry points' arity; WAIT_INFINITE marks a wait whose
+        // timeout is an absolute deadline rather than a relative duration
+        TRACE_PROBE2(wait_begin, event, WAIT_INFINITE);
+
+        // Optimization: early return in case of success for manual reset events only; see the
+        // barrier rationale in WaitForEvent().
+        if (!event->AutoReset && event->State.load(std::memory_order_relaxed)) {
+            if (event->State.load(std::memory_order_acquire)) {
+                TRACE_PROBE2(wait_end, event, 0);
+                return 0;
+            }
+        }
+
+        int tempResult = LockEventMutex(event);
+        assert(tempResult == 0);
+
+        int result = UnlockedWaitForEventUntil(event, &deadline);
+
+        tempResult = pthread_mutex_unlock(&event->Mutex);
+        assert(tempResult == 0);
+
+        TRACE_PROBE2(wait_end, event, result);
+        return result;
+    }
+
+    PEVENTS_INLINE int WaitForEvent(neosmart_event_t event, uint64_t milliseconds) {
+        STAT_INC(event, Waits);
+        TRACE_PROBE2(wait_begin, event, milliseconds);
+
+        // Optimization: bypass acquiring the event lock if the state atomic is unavailable.
+        // memory_order_relaxed (inside LooksSignaled): This is just an optimization, it's OK to
+        // be biased towards a stale value here, and preferable to synchronizing CPU caches to get
+        // a more accurate result.
+        if (milliseconds == 0 && !LooksSignaled(event)) {
+            TRACE_PROBE2(wait_end, event, WAIT_TIMEOUT);
+            return WAIT_TIMEOUT;
+        }
+        // Optimization: early return in case of success for manual reset events only.
+        if (!event->AutoReset && event->State.load(std::memory_order_relaxed)) {
+            // A memory barrier is required here. This is still cheaper than a syscall.
+            // See https://github.com/neosmart/pevents/issues/18
+            if (event->State.load(std::memory_order_acquire)) {
+                TRACE_PROBE2(wait_end, event, 0);
+                return 0;
+            }
+        }
+
+        if (event->SpinWait && milliseconds != 0) {
+            uint32_t budget = event->SpinBudget.load(std::memory_order_relaxed);
+            for (uint32_t spin = 0; spin < budget; ++spin) {
+                // The relaxed pre-check keeps the spin loop read-only (and the cache line shared)
+                // until the event actually looks signaled.
+                if (LooksSignaled(event) && TryObtainEvent(event, std::memory_order_acquire)) {
+                    event->SpinBudget.store(budget < SpinBudgetMax ? budget * 2 : SpinBudgetMax,
+                                            std::memory_order_relaxed);
+                    TRACE_PROBE2(wait_end, event, 0);
+                    return 0;
+                }
+                SpinPause();
+            }
+            // The event wasn't signaled within the spin window; shrink it and fall back to the
+            // blocking path below.
+            event->SpinBudget.store(budget > SpinBudgetMin ? budget / 2 : SpinBudgetMin,
+                                    std::memory_order_relaxed);
+        }
+
+        int tempResult = LockEventMutex(event);
+        assert(tempResult == 0);
+
+        int result = UnlockedWaitForEvent(event, milliseconds);
+
+        tempResult = pthread_mutex_unlock(&event->Mutex);
+        assert(tempResult == 0);
+
+        TRACE_PROBE2(wait_end, event, result);
+        return result;
+    }
+
+#ifdef WFMO
+    // The blocking tail of a multi-event wait: with wfmo->Mutex held and `done` reflecting
+    // whether the wait was already satisfied during setup, block on the wfmo's condition variable
+    // until the wait completes or the absolute CLOCK_MONOTONIC `deadline` (null: wait forever)
+    // passes. Returns with wfmo->Mutex still held.
+    static int WaitForWfmoSignal(neosmart_wfmo_t wfmo, bool waitAll, const timespec *deadline,
+                                 bool done) {
+        int result = 0;
+
+        while (!done) {
+            // One (or more) of the events we're monitoring has been triggered?
+
+            // If we're waiting for all events, assume we're done and check if there's an event that
+            // hasn't fired But if we're waiting for just one event, assume we're not done until we
+            // find a fired event
+            done = (waitAll && wfmo->Status.EventsLeft == 0) ||
+                   (!waitAll && wfmo->Status.FiredEvent != -1);
+
+            if (!done) {
+                if (deadline != nullptr) {
+                    result = TimedWait(&wfmo->CVariable, &wfmo->Mutex, *deadline);
+                } else {
+                    result = pthread_cond_wait(&wfmo->CVariable, &wfmo->Mutex);
+                }
+
+                if (result != 0) {
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    PEVENTS_INLINE int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+                              uint64_t milliseconds) {
+        int unused;
+        return WaitForMultipleEvents(events, count, waitAll, milliseconds, unused);
+    }
+
+    // The common implementation behind the relative-timeout and absolute-deadline entry points:
+    // a non-null `deadline` (absolute CLOCK_MONOTONIC) takes precedence and is handed straight
+    // to the condition variable wait; otherwise `milliseconds` behaves as ever, with the clock
+    // only read if the wait actually has to block. `priority` orders this wait's registrations
+    // within each event's wait list (see AppendWait()).
+    static int WaitForMultipleEventsInternal(neosmart_event_t *events, int count, bool waitAll,
+                                             uint64_t milliseconds, const timespec *deadline,
+                                             int priority, int &waitIndex) {
+        bool poll = deadline == nullptr && milliseconds == 0;
+        waitIndex = -1;
+        TRACE_PROBE3(wfmo_begin, events, count, waitAll);
+
+        // Zero-allocation fast path: a wait that can complete against already-signaled events
+        // needs only stack state — no wfmo object, no mutex or condvar, nothing another thread
+        // ever observes. TryObtainEvent() claims a signaled event exactly as the locked path
+        // would: a plain read for manual-reset, an atomic exchange/decrement for auto-reset/
+        // counted events, arbitrating against concurrent lock-free consumers. The shared waiter
+        // object is only created below once some event actually needs a registration.
+        int claimed = 0;
+        if (waitAll) {
+            // Claim the longest possible prefix; `claimed` doubles as the re-publication record
+            // if the wait can't complete here (contiguous, so no per-event bookkeeping needed)
+            while (claimed < count && TryObtainEvent(events[claimed], std::memory_order_acquire)) {
+                ++claimed;
+            }
+            if (claimed == count) {
+                TRACE_PROBE3(wfmo_end, events, 0, -1);
+                return 0;
+            }
+            if (poll) {
+                // Not satisfiable in one scan: re-publish the claimed prefix (manual-reset
+                // claims consumed nothing; SetEvent() may hand a signal straight to another
+                // waiter, which is exactly re-publication)
+                while (claimed-- > 0) {
+                    if (events[claimed]->AutoReset) {
+                        SetEvent(events[claimed]);
+                    }
+                }
+                TRACE_PROBE3(wfmo_end, events, WAIT_TIMEOUT, -1);
+                return WAIT_TIMEOUT;
+            }
+        } else {
+            for (int i = 0; i < count; ++i) {
+                // The relaxed pre-check keeps the scan read-only (and cache lines shared) until
+                // an event actually looks signaled, as in the spin-wait fast path
+                if (LooksSignaled(events[i]) &&
+                    TryObtainEvent(events[i], std::memory_order_acquire)) {
+                    waitIndex = i;
+                    TRACE_PROBE3(wfmo_end, events, 0, i);
+                    return 0;
+                }
+            }
+            if (poll) {
+                TRACE_PROBE3(wfmo_end, events, WAIT_TIMEOUT, -1);
+                return WAIT_TIMEOUT;
+            }
+        }
+
+        // The slow path: some events need real registrations, so create and publish the shared
+        // waiter object. For waitAll, the first `claimed` events were already consumed above and
+        // their nodes are marked as claims for the timeout re-publication pass.
+        neosmart_wfmo_t wfmo = AcquireWfmo(count);
+
+        int result = 0;
+        int tempResult;
+
+        if (waitAll) {
+            wfmo->Status.EventsLeft = count - claimed;
+        } else {
+            wfmo->Status.FiredEvent = -1;
+        }
+
+        wfmo->WaitAll = waitAll;
+        wfmo->StillWaiting.store(true, std::memory_order_release);
+        // memory_order_release: this is the initial value other threads should see
+        wfmo->RefCount.store(1 + count, std::memory_order_release);
+        // Separately keep track of how many refs to decrement after the initialization loop, to
+        // avoid repeatedly clearing the cache line.
+        int skipped_refs = claimed;
+
+        if (waitAll) {
+            for (int i = 0; i < count; ++i) {
+                wfmo->Waits()[i].Waiter = i < claimed ? nullptr : wfmo;
+            }
+        }
+
+        tempResult = pthread_mutex_lock(&wfmo->Mutex);
+        assert(tempResult == 0);
+
+        bool done = false;
+
+        for (int i = waitAll ? claimed : 0; i < count; ++i) {
+            // One more lock-free claim attempt before paying for the event mutex: the scan above
+            // stopped at the first unclaimable event, but later events may well be signaled
+            if (waitAll && TryObtainEvent(events[i], std::memory_order_acquire)) {
+                wfmo->Waits()[i].Waiter = nullptr;
+                ++skipped_refs;
+                --wfmo->Status.EventsLeft;
+                continue;
+            }
+
+            // Skip obtaining the mutex for manual reset events. This requires a memory barrier to
+            // ensure correctness.
+            bool skipLock = false;
+            if (!events[i]->AutoReset) {
+                if (events[i]->State.load(std::memory_order_relaxed) &&
+                    events[i]->State.load(std::memory_order_acquire)) {
+                    skipLock = true;
+                }
+            }
+
+            if (!skipLock) {
+                // Must not release lock until RegisteredWait is potentially added
+                tempResult = LockEventMutex(events[i]);
+                assert(tempResult == 0);
+
+                // Before adding this wait to the list of registered waits, let's clean up old,
+                // expired waits while we have the event lock anyway.
+                PruneExpiredWaits(events[i]);
+            }
+
+            if (skipLock || UnlockedWaitForEvent(events[i], 0) == 0) {
+                if (!skipLock) {
+                    tempResult = pthread_mutex_unlock(&events[i]->Mutex);
+                    assert(tempResult == 0);
+                }
+
+                if (waitAll) {
+                    // Mark for the timeout re-publication pass, same as a pre-pass claim
+                    wfmo->Waits()[i].Waiter = nullptr;
+                    ++skipped_refs;
+                    --wfmo->Status.EventsLeft;
+                    assert(wfmo->Status.EventsLeft >= 0);
+                } else {
+                    skipped_refs += (count - i);
+                    wfmo->Status.FiredEvent = i;
+                    waitIndex = i;
+                    done = true;
+                    break;
+                }
+            } else {
+                neosmart_wfmo_info_t node = &wfmo->Waits()[i];
+                node->Waiter = wfmo;
+                node->WaitIndex = i;
+                node->Priority = priority;
+                node->Persistent = false;
+                AppendWait(events[i], node);
+                TRACE_PROBE2(wfmo_register, events[i], i);
+
+                tempResult = pthread_mutex_unlock(&events[i]->Mutex);
+                assert(tempResult == 0);
+            }
+        }
+
+        // We set the `done` flag above in case of WaitAny and at least one event was set.
+        // But we need to check again here if we were doing a WaitAll or else we'll incorrectly
+        // return WAIT_TIMEOUT.
+        if (waitAll && wfmo->Status.EventsLeft == 0) {
+            done = true;
+        }
+
+        timespec relativeDeadline;
+        if (deadline == nullptr && milliseconds != WAIT_INFINITE && !done) {
+            DeadlineFromNow(milliseconds, relativeDeadline);
+            deadline = &relativeDeadline;
+        }
+        result = WaitForWfmoSignal(wfmo, waitAll, deadline, done);
+
+        waitIndex = wfmo->Status.FiredEvent;
+        // memory_order_relaxed: this is only checked outside the mutex to determine if waiting has
+        // terminated meaning it's safe to decrement the ref count. If it's true (which we write
+        // with release semantics), then the mutex is always entered.
+        wfmo->StillWaiting.store(false, std::memory_order_relaxed);
+
+        tempResult = pthread_mutex_unlock(&wfmo->Mutex);
+        assert(tempResult == 0);
+
+        // A timed-out (or failed) waitAll re-publishes the signals it consumed while setting up
+        // — the lock-free claims and the events obtained during registration — so a wait that
+        // delivered nothing doesn't eat signals. Manual-reset claims consumed nothing, and
+        // anything delivered to a registered node while blocked was a genuine (kept) delivery.
+        // SetEvent() may hand a re-published signal straight to another waiter, which is fine.
+        // The claim records in Waits() are safe to read here: we still hold our wfmo reference,
+        // and the claimed nodes were never linked onto any event.
+        if (waitAll && result != 0) {
+            for (int i = 0; i < count; ++i) {
+                if (wfmo->Waits()[i].Waiter == nullptr && events[i]->AutoReset) {
+                    SetEvent(events[i]);
+                }
+            }
+        }
+
+        // memory_order_seq_cst: Ensure this is run after the wfmo mutex is unlocked
+        int ref_count = wfmo->RefCount.fetch_sub(1 + skipped_refs, std::memory_order_seq_cst);
+        assert(ref_count > 0);
+        if (ref_count == 1 + skipped_refs) {
+            ReleaseWfmo(wfmo);
+        }
+
+        TRACE_PROBE3(wfmo_end, events, result, waitIndex);
+        return result;
+    }
+
+    PEVENTS_INLINE int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+                              uint64_t milliseconds, int &waitIndex) {
+        return WaitForMultipleEventsInternal(events, count, waitAll, milliseconds, nullptr, 0,
+                                             waitIndex);
+    }
+
+    PEVENTS_INLINE int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+                                             uint64_t milliseconds, int &waitIndex,
+                                             int priority) {
+        return WaitForMultipleEventsInternal(events, count, waitAll, milliseconds, nullptr,
+                                             priority, waitIndex);
+    }
+
+    PEVENTS_INLINE int WaitForEvent(neosmart_event_t event, uint64_t milliseconds, int priority) {
+        // A prioritized single-event wait is a registered wait: unlike the condition-variable
+        // path (where the kernel picks who wakes), a registration participates in the event's
+        // priority-ordered wait list. It pays the registration cost for the privilege.
+        int unused;
+        return WaitForMultipleEventsInternal(&event, 1, false, milliseconds, nullptr, priority,
+                                             unused);
+    }
+
+    PEVENTS_INLINE int WaitForMultipleEventsUntil(neosmart_event_t *events, int count,
+                                                  bool waitAll, const timespec &deadline) {
+        int unused;
+        return WaitForMultipleEventsInternal(events, count, waitAll, WAIT_INFINITE, &deadline, 0,
+                                             unused);
+    }
+
+    PEVENTS_INLINE int WaitForMultipleEventsUntil(neosmart_event_t *events, int count,
+                                                  bool waitAll, const timespec &deadline,
+                                                  int &waitIndex) {
+        return WaitForMultipleEventsInternal(events, count, waitAll, WAIT_INFINITE, &deadline, 0,
+                                             waitIndex);
+    }
+
+    PEVENTS_INLINE int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+                              uint64_t milliseconds, int *signaled, int &signaledCount) {
+        signaledCount = 0;
+
+        int index = -1;
+        int result = WaitForMultipleEvents(events, count, waitAll, milliseconds, index);
+        if (result != 0) {
+            return result;
+        }
+
+        // One registration pass amortized over a burst: the wait itself already consumed the
+        // fired event (every event, for waitAll); whatever else is signaled at this moment is
+        // swept up with the same lock-free consume the spin-wait fast path uses, honoring each
+        // event's reset/count semantics. Events signaled after this pass are left for the next
+        // wait, exactly as if they fired after a plain WFMO returned.
+        for (int i = 0; i < count; ++i) {
+            if (waitAll || i == index ||
+                (LooksSignaled(events[i]) &&
+                 TryObtainEvent(events[i], std::memory_order_acquire))) {
+                signaled[signaledCount++] = i;
+            }
+        }
+
+        return 0;
+    }
+
+    PEVENTS_INLINE int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+                              uint64_t milliseconds, uint64_t &signaledMask) {
+        // One mask bit per event; use the index-span overload for larger groups
+        assert(count <= 64);
+
+        int signaled[64];
+        int signaledCount = 0;
+        signaledMask = 0;
+
+        int result =
+            WaitForMultipleEvents(events, count, waitAll, milliseconds, signaled, signaledCount);
+        if (result != 0) {
+            return result;
+        }
+
+        for (int i = 0; i < signaledCount; ++i) {
+            signaledMask |= (uint64_t)1 << signaled[i];
+        }
+
+        return 0;
+    }
+
+    // A reusable wait-set: the events and the wfmo (with its registration nodes) are wired up
+    // once at creation, and every wait thereafter reuses the standing persistent registrations
+    // instead of linking and unlinking a node per event per wait.
+    struct neosmart_waitset_t_ {
+        neosmart_wfmo_t Wfmo;
+        neosmart_event_t *Events;
+        int Count;
+    };
+
+    PEVENTS_INLINE neosmart_waitset_t CreateWaitSet(neosmart_event_t *events, int count) {
+        neosmart_waitset_t waitset = new neosmart_waitset_t_;
+        waitset->Events = new neosmart_event_t[count];
+        waitset->Count = count;
+
+        neosmart_wfmo_t wfmo = AcquireWfmo(count);
+        waitset->Wfmo = wfmo;
+
+        wfmo->WaitAll = false;
+        wfmo->Status.FiredEvent = -1;
+        wfmo->StillWaiting.store(false, std::memory_order_release);
+        // One reference per linked node, plus one held by the wait-set itself for its lifetime
+        // so the wfmo can never be recycled while the standing registrations exist.
+        wfmo->RefCount.store(1 + count, std::memory_order_release);
+
+        for (int i = 0; i < count; ++i) {
+            waitset->Events[i] = events[i];
+
+            neosmart_wfmo_info_t node = &wfmo->Waits()[i];
+            node->Waiter = wfmo;
+            node->WaitIndex = i;
+            node->Priority = 0;
+            node->Persistent = true;
+            node->Accounted = false;
+
+            int result = pthread_mutex_lock(&events[i]->Mutex);
+            assert(result == 0);
+            AppendWait(events[i], node);
+            ++events[i]->PersistentWaits;
+            result = pthread_mutex_unlock(&events[i]->Mutex);
+            assert(result == 0);
+            (void)result;
+        }
+
+        return waitset;
+    }
+
+    PEVENTS_INLINE int WaitForWaitSet(neosmart_waitset_t waitset, bool waitAll, uint64_t milliseconds) {
+        int unused;
+        return WaitForWaitSet(waitset, waitAll, milliseconds, unused);
+    }
+
+    PEVENTS_INLINE int WaitForWaitSet(neosmart_waitset_t waitset, bool waitAll, uint64_t milliseconds,
+                       int &waitIndex) {
+        neosmart_wfmo_t wfmo = waitset->Wfmo;
+        int count = waitset->Count;
+
+        int tempResult = pthread_mutex_lock(&wfmo->Mutex);
+        assert(tempResult == 0);
+
+        wfmo->WaitAll = waitAll;
+        if (waitAll) {
+            wfmo->Status.EventsLeft = count;
+        } else {
+            wfmo->Status.FiredEvent = -1;
+        }
+        for (int i = 0; i < count; ++i) {
+            wfmo->Waits()[i].Accounted = false;
+        }
+        wfmo->StillWaiting.store(true, std::memory_order_release);
+
+        // Release the wfmo mutex for the duration of the pre-check: SetEvent() locks the wfmo
+        // mutex while holding an event mutex, so locking event mutexes with ours held would
+        // deadlock against a signal aimed at one of our standing registrations. Anything that
+        // fires from here on is delivered through those registrations instead.
+        tempResult = pthread_mutex_unlock(&wfmo->Mutex);
+        assert(tempResult == 0);
+
+        bool done = false;
+        waitIndex = -1;
+
+        for (int i = 0; i < count && !done; ++i) {
+            neosmart_event_t event = waitset->Events[i];
+
+            // The same lock-skipping fast paths used during transient registration, except that
+            // signaled auto-reset events can be consumed without the event mutex thanks to the
+            // exchange in TryObtainEvent()
+            bool obtained = false;
+            bool skipLock = false;
+            if (LooksSignaled(event)) {
+                if (!event->AutoReset) {
+                    if (event->State.load(std::memory_order_acquire)) {
+                        obtained = true;
+                        skipLock = true;
+                    }
+                } else if (TryObtainEvent(event, std::memory_order_acquire)) {
+                    obtained = true;
+                    skipLock = true;
+                }
+            }
+
+            if (!skipLock) {
+                // The event doesn't look signaled; check again under the event mutex so we can't
+                // race a SetEvent() that already walked past our (not-yet-waiting) registration
+                // but has yet to publish the new state.
+                tempResult = LockEventMutex(event);
+                assert(tempResult == 0);
+
+                PruneExpiredWaits(event);
+                obtained = UnlockedWaitForEvent(event, 0) == 0;
+
+                tempResult = pthread_mutex_unlock(&event->Mutex);
+                assert(tempResult == 0);
+            }
+
+            if (obtained) {
+                // Account the event against this wait under the wfmo mutex, since a SetEvent()
+                // may be concurrently delivering other events through our registrations.
+                tempResult = pthread_mutex_lock(&wfmo->Mutex);
+                assert(tempResult == 0);
+
+                neosmart_wfmo_info_t node = &wfmo->Waits()[i];
+                bool kept = false;
+                if (!node->Accounted && (waitAll || wfmo->Status.FiredEvent == -1)) {
+                    node->Accounted = true;
+                    kept = true;
+                    if (waitAll) {
+                        --wfmo->Status.EventsLeft;
+                        assert(wfmo->Status.EventsLeft >= 0);
+                    } else {
+                        wfmo->Status.FiredEvent = i;
+                        // memory_order_relaxed: see the equivalent store in SetEvent()
+                        wfmo->StillWaiting.store(false, std::memory_order_relaxed);
+                    }
+                } else if (!waitAll) {
+                    // A concurrent delivery through one of our standing registrations already
+                    // satisfied the wait; stop scanning so we don't claim further events for a
+                    // wait that can only report one index.
+                    assert(wfmo->Status.FiredEvent != -1);
+                }
+                if (!waitAll && wfmo->Status.FiredEvent != -1) {
+                    done = true;
+                }
+
+                tempResult = pthread_mutex_unlock(&wfmo->Mutex);
+                assert(tempResult == 0);
+
+                // If this claim wasn't counted — the node was already Accounted because a first
+                // signal was delivered through the standing registration and we consumed a
+                // *second* signal here, or a concurrent delivery satisfied a waitAny — the
+                // signal belongs to a future waiter. Re-publish it the way the timed-out
+                // waitAll pass does; manual-reset claims consumed nothing.
+                if (!kept && event->AutoReset) {
+                    SetEvent(event);
+                }
+            }
+        }
+
+        tempResult = pthread_mutex_lock(&wfmo->Mutex);
+        assert(tempResult == 0);
+
+        done = (waitAll && wfmo->Status.EventsLeft == 0) ||
+               (!waitAll && wfmo->Status.FiredEvent != -1);
+
+        int result;
+        if (!done && milliseconds == 0) {
+            result = WAIT_TIMEOUT;
+        } else {
+            timespec deadline;
+            const timespec *until = nullptr;
+            if (!done && milliseconds != WAIT_INFINITE) {
+                DeadlineFromNow(milliseconds, deadline);
+                until = &deadline;
+            }
+            result = WaitForWfmoSignal(wfmo, waitAll, until, done);
+        }
+
+        waitIndex = wfmo->Status.FiredEvent;
+        wfmo->StillWaiting.store(false, std::memory_order_relaxed);
+
+        tempResult = pthread_mutex_unlock(&wfmo->Mutex);
+        assert(tempResult == 0);
+
+        return result;
+    }
+
+    PEVENTS_INLINE int DestroyWaitSet(neosmart_waitset_t waitset) {
+        neosmart_wfmo_t wfmo = waitset->Wfmo;
+
+        for (int i = 0; i < waitset->Count; ++i) {
+            neosmart_event_t event = waitset->Events[i];
+
+            // Events never unlink persistent nodes themselves, so each of ours is still linked
+            int result = pthread_mutex_lock(&event->Mutex);
+            assert(result == 0);
+            UnlinkWait(event, &wfmo->Waits()[i]);
+            --event->PersistentWaits;
+            assert(event->PersistentWaits >= 0);
+            result = pthread_mutex_unlock(&event->Mutex);
+            assert(result == 0);
+            (void)result;
+
+            int ref_count = wfmo->RefCount.fetch_sub(1, std::memory_order_acq_rel);
+            assert(ref_count > 1); // the wait-set's own reference is still outstanding
+            (void)ref_count;
+        }
+
+        // Drop the wait-set's own reference; an in-flight SetEvents() batch may briefly hold one
+        // of its own (see DeferWaiter), in which case it recycles the wfmo when it finishes.
+        int ref_count = wfmo->RefCount.fetch_sub(1, std::memory_order_seq_cst);
+        assert(ref_count > 0);
+        if (ref_count == 1) {
+            ReleaseWfmo(wfmo);
+        }
+
+        delete[] waitset->Events;
+        delete waitset;
+
+        return 0;
+    }
+
+    // An IOCP-style completion port: events are associated once and every subsequent signal is
+    // converted into a queued completion key, so dispatcher threads dequeue fired events in O(1)
+    // instead of re-registering against every event on every wait.
+    struct neosmart_port_t_ {
+        pthread_mutex_t Mutex;
+        pthread_cond_t CVariable;
+        std::deque<uintptr_t> Ready;
+    };
+
+    PEVENTS_INLINE neosmart_port_t CreatePort() {
+        neosmart_port_t port = new neosmart_port_t_;
+
+        int result = pthread_mutex_init(&port->Mutex, 0);
+        assert(result == 0);
+
+        result = InitCondVariable(&port->CVariable);
+        assert(result == 0);
+        (void)result;
+
+        return port;
+    }
+
+    // Queue `count` completions carrying `key` and wake dequeuers. Called with no event mutex
+    // held: the port mutex is the dispatch hot spot and is never nested under per-event locks.
+    static void PortEnqueue(neosmart_port_t port, uintptr_t key, int count) {
+        int result = pthread_mutex_lock(&port->Mutex);
+        assert(result == 0);
+
+        for (int i = 0; i < count; ++i) {
+            port->Ready.push_back(key);
+        }
+
+        result = pthread_mutex_unlock(&port->Mutex);
+        assert(result == 0);
+
+        // One completion wakes one dequeuer; past that a single broadcast is cheaper than
+        // signaling in a loop.
+        if (count == 1) {
+            result = pthread_cond_signal(&port->CVariable);
+        } else {
+            result = pthread_cond_broadcast(&port->CVariable);
+        }
+        assert(result == 0);
+        (void)result;
+    }
+
+    PEVENTS_INLINE int AssociateEvent(neosmart_port_t port, neosmart_event_t event, uintptr_t key) {
+        // Manual-reset events have no one-signal-one-completion semantics to map onto a port
+        if (!event->AutoReset) {
+            return EINVAL;
+        }
+
+        int completions = 0;
+
+        int result = LockEventMutex(event);
+        assert(result == 0);
+
+        event->Port = port;
+        event->PortKey = key;
+
+        if (port != nullptr) {
+            // Convert any signal(s) that arrived before the association into completions
+            while (TryObtainEvent(event, std::memory_order_relaxed)) {
+                ++completions;
+                if (!event->Counted) {
+                    break;
+                }
+            }
+        }
+
+        result = pthread_mutex_unlock(&event->Mutex);
+        assert(result == 0);
+        (void)result;
+
+        if (completions > 0) {
+            PortEnqueue(port, key, completions);
+        }
+
+        return 0;
+    }
+
+    PEVENTS_INLINE int GetQueuedEvent(neosmart_port_t port, uintptr_t &key, uint64_t milliseconds) {
+        int result = pthread_mutex_lock(&port->Mutex);
+        assert(result == 0);
+
+        int waitResult = 0;
+        if (port->Ready.empty()) {
+            if (milliseconds == 0) {
+                waitResult = WAIT_TIMEOUT;
+            } else {
+                timespec deadline;
+                if (milliseconds != WAIT_INFINITE) {
+                    DeadlineFromNow(milliseconds, deadline);
+                }
+
+                while (port->Ready.empty()) {
+                    if (milliseconds != WAIT_INFINITE) {
+                        waitResult = TimedWait(&port->CVariable, &port->Mutex, deadline);
+                    } else {
+                        waitResult = pthread_cond_wait(&port->CVariable, &port->Mutex);
+                    }
+                    if (waitResult != 0) {
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!port->Ready.empty()) {
+            key = port->Ready.front();
+            port->Ready.pop_front();
+            waitResult = 0;
+        }
+
+        result = pthread_mutex_unlock(&port->Mutex);
+        assert(result == 0);
+        (void)result;
+
+        return waitResult;
+    }
+
+    PEVENTS_INLINE int DestroyPort(neosmart_port_t port) {
+        int result = pthread_cond_destroy(&port->CVariable);
+        assert(result == 0);
+
+        result = pthread_mutex_destroy(&port->Mutex);
+        assert(result == 0);
+        (void)result;
+
+        delete port;
+
+        return 0;
+    }
+#endif // WFMO
+
+    // Shared teardown for individually-allocated and arena-constructed events: everything
+    // DestroyEvent() does short of freeing the storage.
+    static void TeardownEvent(neosmart_event_t event) {
         int result = 0;
 
 #ifdef WFMO
-        result = pthread_mutex_lock(&event->Mutex);
+        result = pthread_mutex_lock(&event->Mutex);
+        assert(result == 0);
+        PruneExpiredWaits(event);
+        result = pthread_mutex_unlock(&event->Mutex);
+        assert(result == 0);
+#endif
+#ifdef CORO
+        // An outstanding awaiter's resumption callback would fire against freed memory
+        assert(event->AwaitsHead == nullptr);
+#endif
+
+        result = pthread_cond_destroy(&event->CVariable);
+        assert(result == 0);
+
+        result = pthread_mutex_destroy(&event->Mutex);
+        assert(result == 0);
+        (void)result;
+
+        int fd = event->BridgeFd.load(std::memory_order_relaxed);
+        if (fd != -1) {
+            close(fd);
+            if (event->BridgeWriteFd != fd) {
+                close(event->BridgeWriteFd);
+            }
+        }
+    }
+
+    PEVENTS_INLINE int DestroyEvent(neosmart_event_t event) {
+        TeardownEvent(event);
+        delete event;
+
+        return 0;
+    }
+
+    // A per-thread cache of fully-initialized events — mutex, condvar, and any attached bridge
+    // fd all stay live — so per-request create/destroy churn doesn't pay the allocator plus
+    // pthread init/teardown on every cycle; the same idea as the wfmo pool above. Events are
+    // recycled into the releasing thread's cache; overflow spills onto a bounded global list
+    // that other threads' caches refill from, so a producer thread creating events that a
+    // consumer thread recycles doesn't starve one cache while flooding the other. Beyond both
+    // bounds the event is genuinely destroyed.
+    struct neosmart_event_pool_t_ {
+        static const size_t MaxSize = 16;
+        neosmart_event_t Cache[MaxSize];
+        size_t Size = 0;
+
+        ~neosmart_event_pool_t_();
+    };
+    static thread_local neosmart_event_pool_t_ EventPool;
+
+    static pthread_mutex_t EventOverflowMutex = PTHREAD_MUTEX_INITIALIZER;
+    static neosmart_event_t EventOverflowHead = nullptr;
+    static size_t EventOverflowSize = 0;
+    static const size_t EventOverflowMax = 256;
+
+    neosmart_event_pool_t_::~neosmart_event_pool_t_() {
+        while (Size > 0) {
+            DestroyEvent(Cache[--Size]);
+        }
+    }
+
+    PEVENTS_INLINE neosmart_event_t CreateEventCached(bool manualReset, bool initialState,
+                                                      bool spinWait) {
+        if (EventPool.Size == 0) {
+            // Refill a batch from the global overflow so events recycled by other threads come
+            // back into circulation, amortizing the lock over several future creations
+            int result = pthread_mutex_lock(&EventOverflowMutex);
+            assert(result == 0);
+            while (EventOverflowHead != nullptr &&
+                   EventPool.Size < neosmart_event_pool_t_::MaxSize / 2) {
+                neosmart_event_t head = EventOverflowHead;
+                EventOverflowHead = head->FreeNext;
+                --EventOverflowSize;
+                EventPool.Cache[EventPool.Size++] = head;
+            }
+            result = pthread_mutex_unlock(&EventOverflowMutex);
+            assert(result == 0);
+            (void)result;
+        }
+
+        if (EventPool.Size == 0) {
+            return CreateEvent(manualReset, initialState, spinWait);
+        }
+
+        // Reconfigure the scrubbed event: everything InitializeEvent() sets short of the
+        // still-initialized primitives, the bridge fd, and the (cumulative) stats counters
+        neosmart_event_t event = EventPool.Cache[--EventPool.Size];
+        event->AutoReset = !manualReset;
+        event->SpinWait = spinWait;
+        event->SpinBudget.store(SpinBudgetDefault, std::memory_order_relaxed);
+        // memory_order_release: as with the initial `State` store in InitializeEvent()
+        event->State.store(initialState, std::memory_order_release);
+
+        return event;
+    }
+
+    PEVENTS_INLINE int RecycleEvent(neosmart_event_t event) {
+        int result = pthread_mutex_lock(&event->Mutex);
+        assert(result == 0);
+#ifdef WFMO
+        PruneExpiredWaits(event);
+        // Anything still linked after the sweep is a live registration — recycling out from
+        // under a waiter (or a standing wait-set/port association) is a caller bug, exactly as
+        // it would be for DestroyEvent(). Group members live in their group's arena and must
+        // only be destroyed through DestroyEventGroup().
+        assert(event->WaitsHead == nullptr);
+        assert(event->PersistentWaits == 0);
+        assert(event->Port == nullptr);
+        assert(event->ReadyWord == nullptr);
+#endif
+#ifdef CORO
+        assert(event->AwaitsHead == nullptr);
+#endif
+#ifdef PULSE
+        event->PulseTokens = 0;
+#endif
+        result = pthread_mutex_unlock(&event->Mutex);
+        assert(result == 0);
+        (void)result;
+
+        // Scrub the signaled state; the bridge fd (if one was attached) stays with the event
+        // for its next user, unreadable while the event is parked
+        event->Counted = false;
+        event->Count.store(0, std::memory_order_relaxed);
+        event->State.store(false, std::memory_order_relaxed);
+        DrainBridge(event);
+
+        if (EventPool.Size < neosmart_event_pool_t_::MaxSize) {
+            EventPool.Cache[EventPool.Size++] = event;
+            return 0;
+        }
+
+        result = pthread_mutex_lock(&EventOverflowMutex);
+        assert(result == 0);
+        bool parked = EventOverflowSize < EventOverflowMax;
+        if (parked) {
+            event->FreeNext = EventOverflowHead;
+            EventOverflowHead = event;
+            ++EventOverflowSize;
+        }
+        result = pthread_mutex_unlock(&EventOverflowMutex);
+        assert(result == 0);
+        (void)result;
+
+        return parked ? 0 : DestroyEvent(event);
+    }
+
+    PEVENTS_INLINE int CreateEventArray(neosmart_event_t *out, int count, bool manualReset,
+                                        bool initialState) {
+        assert(count > 0);
+
+        // One aligned arena for the whole block, with every event padded out to its own cache
+        // line(s) so the mutex of one event can't false-share with the hot `State` of its
+        // neighbor — and one allocator call instead of `count`.
+        void *arena = nullptr;
+        if (posix_memalign(&arena, EventCacheLineSize, EventArrayStride() * count) != 0) {
+            return ENOMEM;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            neosmart_event_t event =
+                new (static_cast<char *>(arena) + EventArrayStride() * i) neosmart_event_t_;
+            InitializeEvent(event, manualReset, initialState, false);
+            out[i] = event;
+        }
+
+        return 0;
+    }
+
+    PEVENTS_INLINE int DestroyEventArray(neosmart_event_t *events, int count) {
+        assert(count > 0);
+
+        for (int i = 0; i < count; ++i) {
+            TeardownEvent(events[i]);
+        }
+        // The first event sits at the arena's base address; see CreateEventArray()
+        free(events[0]);
+
+        return 0;
+    }
+
+#ifdef WFMO
+    // A bulk-created event group with a packed readiness bitmap: the events live in one
+    // cache-line-padded arena (exactly as CreateEventArray()) and additionally mirror their
+    // signaled state, one bit per event, into the group's contiguous word array. A group wait
+    // can then locate every signaled member with a handful of sequential 64-bit word reads
+    // instead of pointer-chasing through `count` independent event structures before the wait
+    // even starts, and only touches the events it actually needs to claim or register with.
+    struct neosmart_eventgroup_t_ {
+        neosmart_event_t *Events;
+        std::atomic<uint64_t> *Ready;
+        int Count;
+        int Words;
+    };
+
+    PEVENTS_INLINE neosmart_eventgroup_t CreateEventGroup(neosmart_event_t *out, int count,
+                                                          bool manualReset, bool initialState) {
+        assert(count > 0);
+
+        neosmart_eventgroup_t group = new neosmart_eventgroup_t_;
+        group->Count = count;
+        group->Words = (count + 63) / 64;
+        group->Ready = new std::atomic<uint64_t>[group->Words];
+        for (int w = 0; w < group->Words; ++w) {
+            group->Ready[w].store(0, std::memory_order_relaxed);
+        }
+        group->Events = new neosmart_event_t[count];
+
+        if (CreateEventArray(group->Events, count, manualReset, initialState) != 0) {
+            delete[] group->Events;
+            delete[] group->Ready;
+            delete group;
+            return nullptr;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            group->Events[i]->ReadyWord = &group->Ready[i / 64];
+            group->Events[i]->ReadyMask = (uint64_t)1 << (i % 64);
+            if (initialState) {
+                SetReadyBit(group->Events[i]);
+            }
+            out[i] = group->Events[i];
+        }
+
+        return group;
+    }
+
+    PEVENTS_INLINE int DestroyEventGroup(neosmart_eventgroup_t group) {
+        DestroyEventArray(group->Events, group->Count);
+        delete[] group->Events;
+        delete[] group->Ready;
+        delete group;
+
+        return 0;
+    }
+
+    PEVENTS_INLINE int WaitForEventGroup(neosmart_eventgroup_t group, bool waitAll,
+                                         uint64_t milliseconds, int &waitIndex) {
+        waitIndex = -1;
+
+        if (!waitAll) {
+            // The packed scan: whole words of readiness per load, in index order so the lowest
+            // signaled index wins as with the per-event scan. Bits past `Count` are never set.
+            // An empty-looking bitmap proves nothing (a bit may be transiently stale-zero), so
+            // a scan that comes up dry falls through to the authoritative per-event scan below
+            // rather than declaring a timeout.
+            for (int w = 0; w < group->Words; ++w) {
+                uint64_t ready = group->Ready[w].load(std::memory_order_relaxed);
+                while (ready != 0) {
+                    int i = w * 64 + __builtin_ctzll(ready);
+                    ready &= ready - 1;
+                    if (TryObtainEvent(group->Events[i], std::memory_order_acquire)) {
+                        waitIndex = i;
+                        return 0;
+                    }
+                }
+            }
+        }
+
+        return WaitForMultipleEventsInternal(group->Events, group->Count, waitAll, milliseconds,
+                                             nullptr, 0, waitIndex);
+    }
+
+    PEVENTS_INLINE int WaitForEventGroup(neosmart_eventgroup_t group, bool waitAll,
+                                         uint64_t milliseconds, uint64_t &signaledMask) {
+        // One mask bit per event, as with the burst-draining WFMO variant
+        assert(group->Count <= 64);
+        signaledMask = 0;
+
+        int index = -1;
+        int result = WaitForEventGroup(group, waitAll, milliseconds, index);
+        if (result != 0) {
+            return result;
+        }
+
+        if (waitAll) {
+            signaledMask = group->Count == 64 ? ~(uint64_t)0
+                                              : (((uint64_t)1 << group->Count) - 1);
+            return 0;
+        }
+
+        signaledMask = (uint64_t)1 << index;
+        // Burst sweep straight off the bitmap: claim whatever else is signaled at this moment,
+        // touching only the events whose bits are set. The bits are an ordering hint and the
+        // sweep is best-effort by nature — a member missed because its bit was transiently
+        // stale-zero is simply reported by a later call, exactly like a signal arriving just
+        // after the sweep.
+        uint64_t ready = group->Ready[0].load(std::memory_order_relaxed) & ~signaledMask;
+        while (ready != 0) {
+            int i = __builtin_ctzll(ready);
+            ready &= ready - 1;
+            if (TryObtainEvent(group->Events[i], std::memory_order_acquire)) {
+                signaledMask |= (uint64_t)1 << i;
+            }
+        }
+
+        return 0;
+    }
+#endif // WFMO
+
+    // Wakeups deferred while SetEvents() walks a batch of events, so that every notification is
+    // issued only after all of the batch's event mutexes have been released. A WFMO waiter that
+    // is registered with several events in the batch is signaled exactly once; the references
+    // held on behalf of deferred waiters are not dropped until after their signal is issued, so
+    // a concurrently timing-out waiter can't release the wfmo out from under us.
+    struct neosmart_event_batch_t_ {
+#ifdef WFMO
+        std::vector<std::pair<neosmart_wfmo_t, int>> Waiters; // waiter and pending ref drops
+#endif
+        std::vector<neosmart_event_t> Events; // events whose own condvar needs notifying
+
+#ifdef WFMO
+        void DeferWaiter(neosmart_wfmo_t waiter) {
+            for (auto &entry : Waiters) {
+                if (entry.first == waiter) {
+                    ++entry.second;
+                    return;
+                }
+            }
+            Waiters.push_back(std::make_pair(waiter, 1));
+        }
+#endif
+
+        void Flush() {
+            for (neosmart_event_t event : Events) {
+                int result = event->AutoReset ? pthread_cond_signal(&event->CVariable)
+                                              : pthread_cond_broadcast(&event->CVariable);
+                assert(result == 0);
+                (void)result;
+            }
+            Events.clear();
+
+#ifdef WFMO
+            for (auto &entry : Waiters) {
+                int result = pthread_cond_signal(&entry.first->CVariable);
+                assert(result == 0);
+                (void)result;
+
+                // memory_order_seq_cst: Ensure this is run after the wfmo mutex is unlocked
+                int ref_count =
+                    entry.first->RefCount.fetch_sub(entry.second, std::memory_order_seq_cst);
+                assert(ref_count >= entry.second);
+                if (ref_count == entry.second) {
+                    ReleaseWfmo(entry.first);
+                }
+            }
+            Waiters.clear();
+#endif
+        }
+    };
+
+    // With `pulse` set, the signal is delivered to the current waiter set only (one delivery for
+    // auto-reset, everyone for manual-reset) under the same single lock acquisition, and `State`
+    // is never published — blocked single-event waiters take the pulse via the generation/token
+    // check in UnlockedWaitForEvent() instead.
+    static int SetEventInternal(neosmart_event_t event, neosmart_event_batch_t_ *batch,
+                                bool pulse) {
+        if (event->Counted && !pulse) {
+            // A plain SetEvent() on a counted event releases a single unit. Counted releases
+            // issue their own (already coalesced) notifications, so the batch isn't needed.
+            // (A pulse falls through to the auto-reset path: nothing is added to the count.)
+            return ReleaseEvent(event, 1);
+        }
+
+        int result = LockEventMutex(event);
+        assert(result == 0);
+
+        // Depending on the event type, we either trigger everyone or only one
+        if (event->AutoReset) {
+#ifdef WFMO
+            for (neosmart_wfmo_info_t i = event->WaitsHead, next = nullptr; i != nullptr;
+                 i = next) {
+                // Read the link before processing: if this node's reference is dropped below, the
+                // node (which lives in the waiter's allocation) may be freed out from under us
+                next = i->Next;
+
+                // memory_order_relaxed: this is just an optimization to see if it is OK to skip
+                // this waiter, and if it's observed to be false then it's OK to bypass the mutex at
+                // that point. Persistent (wait-set) nodes are simply left in place until their
+                // waiter next waits; every wait-set waiter synchronizes with us through the event
+                // mutex before it can block, so there is no wakeup to lose here.
+                if (!i->Waiter->StillWaiting.load(std::memory_order_relaxed)) {
+                    if (!i->Persistent) {
+                        // Unlink before dropping the list's reference; see PruneExpiredWaits
+                        UnlinkWait(event, i);
+                        STAT_INC(event, ExpiredWaits);
+
+                        int ref_count = i->Waiter->RefCount.fetch_sub(1, std::memory_order_acq_rel);
+                        assert(ref_count > 0);
+                        if (ref_count == 1) {
+                            ReleaseWfmo(i->Waiter);
+                        }
+                    }
+                    continue;
+                }
+
+                result = pthread_mutex_lock(&i->Waiter->Mutex);
+                assert(result == 0);
+
+                // We have to check `Waiter->StillWaiting` twice, once before locking as an
+                // optimization to bypass the mutex altogether, and then again after locking the
+                // WFMO mutex because we could have !waitAll and another event could have ended the
+                // wait, in which case we must not unlock the same waiter or else a SetEvent() call
+                // on an auto-reset event may end up with a lost wakeup. A persistent node that has
+                // already been delivered this event during the current wait is likewise passed
+                // over so it can't absorb a second signal.
+                if (!i->Waiter->StillWaiting.load(std::memory_order_relaxed) ||
+                    (i->Persistent && i->Accounted)) {
+                    bool expired = !i->Waiter->StillWaiting.load(std::memory_order_relaxed);
+                    result = pthread_mutex_unlock(&i->Waiter->Mutex);
+                    assert(result == 0);
+
+                    if (expired && !i->Persistent) {
+                        UnlinkWait(event, i);
+                        STAT_INC(event, ExpiredWaits);
+
+                        // memory_order_seq_cst: Ensure this is run after the wfmo mutex is unlocked
+                        int ref_count = i->Waiter->RefCount.fetch_sub(1, std::memory_order_seq_cst);
+                        assert(ref_count > 0);
+                        if (ref_count == 1) {
+                            ReleaseWfmo(i->Waiter);
+                        }
+                    }
+                    continue;
+                }
+
+                i->Accounted = true;
+                STAT_INC(event, WaitersWoken);
+                if (i->Waiter->WaitAll) {
+                    --i->Waiter->Status.EventsLeft;
+                    assert(i->Waiter->Status.EventsLeft >= 0);
+                    // We technically should do i->Waiter->StillWaiting = Waiter->Status.EventsLeft
+                    // != 0 but the only time it'll be equal to zero is if we're the last event, so
+                    // no one else will be checking the StillWaiting flag. We're good to go without
+                    // it.
+                } else {
+                    i->Waiter->Status.FiredEvent = i->WaitIndex;
+                    // memory_order_relaxed: The flip to false is only lazily observed as an
+                    // optimization to bypass the mutex for cleanup.
+                    i->Waiter->StillWaiting.store(false, std::memory_order_relaxed);
+                }
+
+                result = pthread_mutex_unlock(&i->Waiter->Mutex);
+                assert(result == 0);
+
+                if (!i->Persistent) {
+                    UnlinkWait(event, i);
+                }
+
+                if (batch != nullptr) {
+                    // The waiter's signal (and the accompanying reference drop) is issued by
+                    // Flush() once the whole batch has been walked. A persistent node's list
+                    // reference isn't ours to transfer, so take one out to keep the waiter alive
+                    // until it has been signaled.
+                    if (i->Persistent) {
+                        i->Waiter->RefCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    batch->DeferWaiter(i->Waiter);
+                } else {
+                    result = pthread_cond_signal(&i->Waiter->CVariable);
+                    assert(result == 0);
+
+                    if (!i->Persistent) {
+                        // memory_order_seq_cst: Ensure this is run after the wfmo mutex is
+                        // unlocked
+                        int ref_count = i->Waiter->RefCount.fetch_sub(1, std::memory_order_seq_cst);
+                        assert(ref_count > 0);
+                        if (ref_count == 1) {
+                            ReleaseWfmo(i->Waiter);
+                        }
+                    }
+                }
+
+                result = pthread_mutex_unlock(&event->Mutex);
+                assert(result == 0);
+
+                return 0;
+            }
+#endif // WFMO
+#ifdef CORO
+            // No multi-event waiter took the signal; hand it to the oldest registered awaiter,
+            // whose coroutine is resumed on this thread once the event mutex is dropped.
+            if (event->AwaitsHead != nullptr) {
+                neosmart_await_t_ *await = PopAwait(event);
+                STAT_INC(event, WaitersWoken);
+
+                result = pthread_mutex_unlock(&event->Mutex);
+                assert(result == 0);
+
+                await->Resume(await->Context);
+                return 0;
+            }
+#endif
+#ifdef WFMO
+            // No multi-event waiter took the signal; a port association converts it into a
+            // queued completion instead of storing it in the event. A pulse is never stored, so
+            // it bypasses the port entirely.
+            if (!pulse && event->Port != nullptr) {
+                neosmart_port_t port = event->Port;
+                uintptr_t key = event->PortKey;
+
+                result = pthread_mutex_unlock(&event->Mutex);
+                assert(result == 0);
+
+                PortEnqueue(port, key, 1);
+                return 0;
+            }
+#endif
+#ifdef PULSE
+            if (pulse) {
+                // Leave a single pulse token for whichever already-blocked waiter wakes first;
+                // `State` stays false so a late-arriving wait observes nothing.
+                ++event->PulseGeneration;
+                event->PulseTokens = 1;
+            } else
+#endif
+                // memory_order_release: this is the synchronization point for any threads
+                // spin-waiting for the event to become available. An exchange rather than a store
+                // so the bridge fd is only signaled on an actual unsignaled-to-signaled
+                // transition.
+                if (!event->State.exchange(true, std::memory_order_release)) {
+#ifdef WFMO
+                    SetReadyBit(event);
+#endif
+                    if (event->BridgeFd.load(std::memory_order_relaxed) != -1) {
+                        SignalBridgeFd(event->BridgeWriteFd);
+                    }
+                }
+
+            result = pthread_mutex_unlock(&event->Mutex);
+            assert(result == 0);
+
+            if (batch != nullptr) {
+                batch->Events.push_back(event);
+            } else {
+                result = pthread_cond_signal(&event->CVariable);
+                assert(result == 0);
+            }
+
+            return 0;
+        } else { // this is a manual reset event
+#ifdef PULSE
+            if (pulse) {
+                // Release every currently-blocked waiter via the generation bump; `State` stays
+                // false so a late-arriving wait observes nothing.
+                ++event->PulseGeneration;
+            } else
+#endif
+                // memory_order_release: this is the synchronization point for any threads
+                // spin-waiting for the event to become available. An exchange rather than a store
+                // so the bridge fd is only signaled on an actual unsignaled-to-signaled
+                // transition.
+                if (!event->State.exchange(true, std::memory_order_release)) {
+#ifdef WFMO
+                    SetReadyBit(event);
+#endif
+                    if (event->BridgeFd.load(std::memory_order_relaxed) != -1) {
+                        SignalBridgeFd(event->BridgeWriteFd);
+                    }
+                }
+#ifdef WFMO
+            // Snapshot-and-swap broadcast: when every registered wait is transient, detach the
+            // whole list here (O(1) with the event mutex held) and notify the waiters after it's
+            // released, so a broadcast to thousands of waiters doesn't stall every other
+            // operation on the event behind an in-lock walk. Persistent (wait-set) nodes must
+            // stay linked, so their presence forces the in-place walk.
+            neosmart_wfmo_info_t detached = nullptr;
+            if (event->PersistentWaits == 0) {
+                detached = event->WaitsHead;
+                event->WaitsHead = nullptr;
+                event->WaitsTail = nullptr;
+            } else
+            for (neosmart_wfmo_info_t info = event->WaitsHead, next = nullptr; info != nullptr;
+                 info = next) {
+                // Read the link before processing: once this node's reference is dropped, the
+                // node (which lives in the waiter's allocation) may be freed out from under us
+                next = info->Next;
+
+                // memory_order_relaxed: this is just an optimization to see if it is OK to skip
+                // this waiter, and if it's observed to be false then it's OK to bypass the mutex at
+                // that point. Persistent (wait-set) nodes stay linked; their waiter will observe
+                // the manual-reset state directly on its next wait.
+                if (!info->Waiter->StillWaiting.load(std::memory_order_relaxed)) {
+                    if (!info->Persistent) {
+                        // Unlink before dropping the list's reference; see PruneExpiredWaits
+                        UnlinkWait(event, info);
+                        STAT_INC(event, ExpiredWaits);
+
+                        int ref_count =
+                            info->Waiter->RefCount.fetch_sub(1, std::memory_order_acq_rel);
+                        if (ref_count == 1) {
+                            ReleaseWfmo(info->Waiter);
+                        }
+                    }
+                    continue;
+                }
+
+                result = pthread_mutex_lock(&info->Waiter->Mutex);
+                assert(result == 0);
+
+                // For transient nodes, Waiter->StillWaiting may have become true by now, but we're
+                // just going to pretend it hasn't. So long as we hold a reference to the WFMO,
+                // this is safe since manual reset events are not one-time use. Persistent nodes
+                // must be checked for real, though: delivering to a wait-set that isn't currently
+                // waiting (or that has already been delivered this event during the current wait)
+                // would corrupt the accounting of its next wait.
+                if (info->Persistent &&
+                    (!info->Waiter->StillWaiting.load(std::memory_order_relaxed) ||
+                     info->Accounted)) {
+                    result = pthread_mutex_unlock(&info->Waiter->Mutex);
+                    assert(result == 0);
+                    continue;
+                }
+
+                info->Accounted = true;
+                STAT_INC(event, WaitersWoken);
+                if (info->Waiter->WaitAll) {
+                    --info->Waiter->Status.EventsLeft;
+                    assert(info->Waiter->Status.EventsLeft >= 0);
+                    // We technically should do i->Waiter->StillWaiting = Waiter->Status.EventsLeft
+                    // != 0 but the only time it'll be equal to zero is if we're the last event, so
+                    // no one else will be checking the StillWaiting flag. We're good to go without
+                    // it.
+                } else {
+                    info->Waiter->Status.FiredEvent = info->WaitIndex;
+                    // memory_order_relaxed: The flip to false is only lazily observed as an
+                    // optimization to bypass the mutex for cleanup.
+                    info->Waiter->StillWaiting.store(false, std::memory_order_relaxed);
+                }
+
+                result = pthread_mutex_unlock(&info->Waiter->Mutex);
+                assert(result == 0);
+
+                if (!info->Persistent) {
+                    UnlinkWait(event, info);
+                }
+
+                if (batch != nullptr) {
+                    // See the persistent-node note in the auto-reset path above
+                    if (info->Persistent) {
+                        info->Waiter->RefCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    batch->DeferWaiter(info->Waiter);
+                    continue;
+                }
+
+                result = pthread_cond_signal(&info->Waiter->CVariable);
+                assert(result == 0);
+
+                if (!info->Persistent) {
+                    // memory_order_seq_cst: Ensure this is run after the wfmo mutex is unlocked
+                    int ref_count = info->Waiter->RefCount.fetch_sub(1, std::memory_order_seq_cst);
+                    assert(ref_count > 0);
+                    if (ref_count == 1) {
+                        ReleaseWfmo(info->Waiter);
+                    }
+                }
+                continue;
+            }
+#endif // WFMO
+#ifdef CORO
+            // A manual-reset signal releases every registered awaiter, resumed (in registration
+            // order) once the event mutex and notifications are out of the way.
+            neosmart_await_t_ *awaits = DetachAwaits(event);
+#ifdef STATS
+            for (neosmart_await_t_ *await = awaits; await != nullptr; await = await->Next) {
+                STAT_INC(event, WaitersWoken);
+            }
+#endif
+#endif
+            result = pthread_mutex_unlock(&event->Mutex);
+            assert(result == 0);
+
+            if (batch != nullptr) {
+                batch->Events.push_back(event);
+            } else {
+                result = pthread_cond_broadcast(&event->CVariable);
+                assert(result == 0);
+            }
+#ifdef WFMO
+            // Deliver to the detached (all-transient) waits with no event locks held. Each node
+            // came off the list with the list's reference to its waiter, which keeps the wfmo
+            // (and the node, which lives inside its allocation) alive until we're done with it —
+            // read the link before processing, as dropping the reference may free both.
+            for (neosmart_wfmo_info_t info = detached, next = nullptr; info != nullptr;
+                 info = next) {
+                next = info->Next;
+
+                if (!info->Waiter->StillWaiting.load(std::memory_order_relaxed)) {
+                    STAT_INC(event, ExpiredWaits);
+
+                    int ref_count = info->Waiter->RefCount.fetch_sub(1, std::memory_order_acq_rel);
+                    assert(ref_count > 0);
+                    if (ref_count == 1) {
+                        ReleaseWfmo(info->Waiter);
+                    }
+                    continue;
+                }
+
+                result = pthread_mutex_lock(&info->Waiter->Mutex);
+                assert(result == 0);
+
+                // As in the in-place walk: StillWaiting may have flipped back to true by now, but
+                // delivering anyway is safe for a manual-reset event so long as we hold a
+                // reference to the wfmo.
+                STAT_INC(event, WaitersWoken);
+                if (info->Waiter->WaitAll) {
+                    --info->Waiter->Status.EventsLeft;
+                    assert(info->Waiter->Status.EventsLeft >= 0);
+                } else {
+                    info->Waiter->Status.FiredEvent = info->WaitIndex;
+                    // memory_order_relaxed: The flip to false is only lazily observed as an
+                    // optimization to bypass the mutex for cleanup.
+                    info->Waiter->StillWaiting.store(false, std::memory_order_relaxed);
+                }
+
+                result = pthread_mutex_unlock(&info->Waiter->Mutex);
+                assert(result == 0);
+
+                if (batch != nullptr) {
+                    // The list's reference travels with the deferred waiter; Flush() drops it
+                    // after the signal is issued.
+                    batch->DeferWaiter(info->Waiter);
+                    continue;
+                }
+
+                result = pthread_cond_signal(&info->Waiter->CVariable);
+                assert(result == 0);
+
+                int ref_count = info->Waiter->RefCount.fetch_sub(1, std::memory_order_seq_cst);
+                assert(ref_count > 0);
+                if (ref_count == 1) {
+                    ReleaseWfmo(info->Waiter);
+                }
+            }
+#endif // WFMO
+#ifdef CORO
+            ResumeAwaits(awaits);
+#endif
+        }
+
+        return 0;
+    }
+
+    PEVENTS_INLINE int SetEvent(neosmart_event_t event) {
+        TRACE_PROBE1(set, event);
+        return SetEventInternal(event, nullptr, false);
+    }
+
+    PEVENTS_INLINE int ReleaseEvent(neosmart_event_t event, int count) {
+        assert(event->Counted);
+        if (!event->Counted || count < 0) {
+            return EINVAL;
+        }
+        if (count == 0) {
+            return 0;
+        }
+
+        neosmart_event_batch_t_ batch;
+
+        int result = LockEventMutex(event);
         assert(result == 0);
-        event->RegisteredWaits.erase(std::remove_if(event->RegisteredWaits.begin(),
-                                                    event->RegisteredWaits.end(),
-                                                    RemoveExpiredWaitHelper),
-                                     event->RegisteredWaits.end());
+
+        int remaining = count;
+#ifdef WFMO
+        // Mirrors the auto-reset walk in SetEventInternal(), except that up to `remaining`
+        // registered waits are delivered under this single lock acquisition; the wakeups are
+        // batched and issued after the event mutex is released.
+        for (neosmart_wfmo_info_t i = event->WaitsHead, next = nullptr;
+             i != nullptr && remaining > 0; i = next) {
+            // Read the link before processing: if this node's reference is dropped below, the
+            // node (which lives in the waiter's allocation) may be freed out from under us
+            next = i->Next;
+
+            if (!i->Waiter->StillWaiting.load(std::memory_order_relaxed)) {
+                if (!i->Persistent) {
+                    // Unlink before dropping the list's reference; see PruneExpiredWaits
+                    UnlinkWait(event, i);
+                    STAT_INC(event, ExpiredWaits);
+
+                    int ref_count = i->Waiter->RefCount.fetch_sub(1, std::memory_order_acq_rel);
+                    assert(ref_count > 0);
+                    if (ref_count == 1) {
+                        ReleaseWfmo(i->Waiter);
+                    }
+                }
+                continue;
+            }
+
+            result = pthread_mutex_lock(&i->Waiter->Mutex);
+            assert(result == 0);
+
+            // See the corresponding double-check in SetEventInternal()
+            if (!i->Waiter->StillWaiting.load(std::memory_order_relaxed) ||
+                (i->Persistent && i->Accounted)) {
+                bool expired = !i->Waiter->StillWaiting.load(std::memory_order_relaxed);
+                result = pthread_mutex_unlock(&i->Waiter->Mutex);
+                assert(result == 0);
+
+                if (expired && !i->Persistent) {
+                    UnlinkWait(event, i);
+                    STAT_INC(event, ExpiredWaits);
+
+                    int ref_count = i->Waiter->RefCount.fetch_sub(1, std::memory_order_seq_cst);
+                    assert(ref_count > 0);
+                    if (ref_count == 1) {
+                        ReleaseWfmo(i->Waiter);
+                    }
+                }
+                continue;
+            }
+
+            i->Accounted = true;
+            STAT_INC(event, WaitersWoken);
+            if (i->Waiter->WaitAll) {
+                --i->Waiter->Status.EventsLeft;
+                assert(i->Waiter->Status.EventsLeft >= 0);
+            } else {
+                i->Waiter->Status.FiredEvent = i->WaitIndex;
+                // memory_order_relaxed: The flip to false is only lazily observed as an
+                // optimization to bypass the mutex for cleanup.
+                i->Waiter->StillWaiting.store(false, std::memory_order_relaxed);
+            }
+
+            result = pthread_mutex_unlock(&i->Waiter->Mutex);
+            assert(result == 0);
+
+            if (!i->Persistent) {
+                UnlinkWait(event, i);
+            } else {
+                // A persistent node's list reference isn't ours to transfer to the batch; take
+                // one out to keep the waiter alive until it has been signaled.
+                i->Waiter->RefCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            batch.DeferWaiter(i->Waiter);
+
+            --remaining;
+        }
+#endif // WFMO
+
+#ifdef CORO
+        // Leftover units next go to registered awaiters, oldest first, one unit apiece; the
+        // detached chain is resumed after the event mutex is released.
+        neosmart_await_t_ *awaits = nullptr;
+        neosmart_await_t_ **awaitsTail = &awaits;
+        while (remaining > 0 && event->AwaitsHead != nullptr) {
+            neosmart_await_t_ *await = PopAwait(event);
+            STAT_INC(event, WaitersWoken);
+            await->Next = nullptr;
+            *awaitsTail = await;
+            awaitsTail = &await->Next;
+            --remaining;
+        }
+#endif
+
+#ifdef WFMO
+        // Leftover units on a port-associated event become queued completions rather than
+        // pending count
+        if (remaining > 0 && event->Port != nullptr) {
+            neosmart_port_t port = event->Port;
+            uintptr_t key = event->PortKey;
+
+            result = pthread_mutex_unlock(&event->Mutex);
+            assert(result == 0);
+
+            PortEnqueue(port, key, remaining);
+            batch.Flush();
+#ifdef CORO
+            ResumeAwaits(awaits);
+#endif
+            return 0;
+        }
+#endif // WFMO
+
+        if (remaining > 0) {
+            // memory_order_release: publication point for lock-free consumers; see SetEvent().
+            // fetch_add rather than a plain store because spin-waiting consumers decrement the
+            // count without holding the event mutex.
+            int prior = event->Count.fetch_add(remaining, std::memory_order_release);
+            if (prior == 0 && event->BridgeFd.load(std::memory_order_relaxed) != -1) {
+                SignalBridgeFd(event->BridgeWriteFd);
+            }
+        }
+
         result = pthread_mutex_unlock(&event->Mutex);
         assert(result == 0);
+
+        if (remaining > 0) {
+            // One coalesced notification: every blocked waiter re-checks the count, up to
+            // `remaining` of them consume a unit, and surplus wakeups go back to sleep.
+            result = pthread_cond_broadcast(&event->CVariable);
+            assert(result == 0);
+        }
+
+        batch.Flush();
+#ifdef CORO
+        ResumeAwaits(awaits);
 #endif
 
-        result = pthread_cond_destroy(&event->CVariable);
+        return 0;
+    }
+
+    PEVENTS_INLINE int SetEvents(neosmart_event_t *events, int count) {
+        neosmart_event_batch_t_ batch;
+
+        for (int i = 0; i < count; ++i) {
+            int result = SetEventInternal(events[i], &batch, false);
+            assert(result == 0);
+            (void)result;
+        }
+
+        // All of the batch's event mutexes have been released; issue the coalesced notifications.
+        batch.Flush();
+
+        return 0;
+    }
+
+    PEVENTS_INLINE int ResetEvent(neosmart_event_t event) {
+        // memory_order_relaxed and no mutex: there can't be any guarantees about concurrent calls
+        // to either of WFMO()/SetEvent() and ResetEvent() because they're racy by nature. Only the
+        // behavior of concurrent WFMO() and SetEvent() calls is strongly defined.
+        event->State.store(false, std::memory_order_relaxed);
+#ifdef WFMO
+        ClearReadyBit(event);
+#endif
+        if (event->Counted) {
+            event->Count.store(0, std::memory_order_relaxed);
+        }
+        DrainBridge(event);
+        return 0;
+    }
+
+    PEVENTS_INLINE int GetEventFd(neosmart_event_t event) {
+        int fd = event->BridgeFd.load(std::memory_order_acquire);
+        if (fd != -1) {
+            return fd;
+        }
+
+        // Attach under the event mutex so creation can't race another GetEventFd() call or a
+        // concurrent signaled-state transition.
+        int result = pthread_mutex_lock(&event->Mutex);
         assert(result == 0);
 
-        result = pthread_mutex_destroy(&event->Mutex);
+        fd = event->BridgeFd.load(std::memory_order_relaxed);
+        if (fd == -1) {
+            int writeFd;
+            fd = CreateBridgeFd(writeFd);
+            if (fd != -1) {
+                event->BridgeWriteFd = writeFd;
+                // Catch up with a state that was signaled before the bridge existed
+                if (LooksSignaled(event)) {
+                    SignalBridgeFd(writeFd);
+                }
+                event->BridgeFd.store(fd, std::memory_order_release);
+            }
+        }
+
+        result = pthread_mutex_unlock(&event->Mutex);
         assert(result == 0);
+        (void)result;
 
-        delete event;
+        return fd;
+    }
 
-        return 0;
+    // A cross-process event placement-constructed into caller-provided shared memory, built on
+    // PTHREAD_PROCESS_SHARED primitives. It deliberately does not reuse neosmart_event_t_: that
+    // layout shifts with the build's feature macros and carries process-local pointers (WFMO wait
+    // lists, ports, bridge fds), none of which can cross an address-space boundary. Shared events
+    // get the plain signal/wait protocol only. The magic value is backend-specific on purpose — a
+    // futex-backed build must not attach to a pthread-backed event (the layouts share nothing).
+    static const uint32_t EventSharedMagic = 0x70457650; // "PvEp"
+
+    struct neosmart_event_shared_t_ {
+        pthread_mutex_t Mutex;
+        pthread_cond_t CVariable;
+        bool State;
+        bool AutoReset;
+        // Written last (release) by CreateEventShared() so OpenEventShared() in another process
+        // can't observe a half-constructed event.
+        std::atomic<uint32_t> Magic;
+    };
+
+    PEVENTS_INLINE size_t EventSharedSize() {
+        return sizeof(neosmart_event_shared_t_);
+    }
+
+    PEVENTS_INLINE neosmart_event_shared_t CreateEventShared(void *region, bool manualReset,
+                                                             bool initialState) {
+        neosmart_event_shared_t event = new (region) neosmart_event_shared_t_;
+
+        event->State = initialState;
+        event->AutoReset = !manualReset;
+
+        pthread_mutexattr_t mutexAttr;
+        int result = pthread_mutexattr_init(&mutexAttr);
+        assert(result == 0);
+        result = pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+        assert(result == 0);
+        result = pthread_mutex_init(&event->Mutex, &mutexAttr);
+        assert(result == 0);
+        pthread_mutexattr_destroy(&mutexAttr);
+
+        pthread_condattr_t condAttr;
+        result = pthread_condattr_init(&condAttr);
+        assert(result == 0);
+        result = pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+        assert(result == 0);
+#ifndef __APPLE__
+        // Monotonic deadlines, same as InitCondVariable(); Apple waits relatively via TimedWait()
+        result = pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+        assert(result == 0);
+#endif
+        result = pthread_cond_init(&event->CVariable, &condAttr);
+        assert(result == 0);
+        pthread_condattr_destroy(&condAttr);
+        (void)result;
+
+        event->Magic.store(EventSharedMagic, std::memory_order_release);
+
+        return event;
+    }
+
+    PEVENTS_INLINE neosmart_event_shared_t OpenEventShared(void *region) {
+        neosmart_event_shared_t event = static_cast<neosmart_event_shared_t>(region);
+        // memory_order_acquire: pairs with the publishing store in CreateEventShared()
+        if (event->Magic.load(std::memory_order_acquire) != EventSharedMagic) {
+            return nullptr;
+        }
+        return event;
+    }
+
+    PEVENTS_INLINE int WaitForEventShared(neosmart_event_shared_t event, uint64_t milliseconds) {
+        timespec deadline;
+        if (milliseconds != 0 && milliseconds != WAIT_INFINITE) {
+            DeadlineFromNow(milliseconds, deadline);
+        }
+
+        int tempResult = pthread_mutex_lock(&event->Mutex);
+        assert(tempResult == 0);
+
+        int result = 0;
+        while (!event->State) {
+            if (milliseconds == 0) {
+                result = WAIT_TIMEOUT;
+                break;
+            }
+            if (milliseconds == WAIT_INFINITE) {
+                result = pthread_cond_wait(&event->CVariable, &event->Mutex);
+            } else {
+                result = TimedWait(&event->CVariable, &event->Mutex, deadline);
+            }
+            if (result == ETIMEDOUT) {
+                result = WAIT_TIMEOUT;
+                break;
+            }
+            assert(result == 0);
+        }
+
+        if (result == 0 && event->AutoReset) {
+            event->State = false;
+        }
+
+        tempResult = pthread_mutex_unlock(&event->Mutex);
+        assert(tempResult == 0);
+        (void)tempResult;
+
+        return result;
     }
 
-    int SetEvent(neosmart_event_t event) {
+    PEVENTS_INLINE int SetEventShared(neosmart_event_shared_t event) {
         int result = pthread_mutex_lock(&event->Mutex);
         assert(result == 0);
 
-        // Depending on the event type, we either trigger everyone or only one
+        event->State = true;
         if (event->AutoReset) {
-#ifdef WFMO
-            while (!event->RegisteredWaits.empty()) {
-                neosmart_wfmo_info_t i = &event->RegisteredWaits.front();
+            result = pthread_cond_signal(&event->CVariable);
+        } else {
+            result = pthread_cond_broadcast(&event->CVariable);
+        }
+        assert(result == 0);
 
-                // memory_order_relaxed: this is just an optimization to see if it is OK to skip
-                // this waiter, and if it's observed to be false then it's OK to bypass the mutex at
-                // that point.
-                if (!i->Waiter->StillWaiting.load(std::memory_order_relaxed)) {
-                    int ref_count = i->Waiter->RefCount.fetch_sub(1, std::memory_order_acq_rel);
-                    assert(ref_count > 0);
-                    if (ref_count == 1) {
-                        i->Waiter->Destroy();
-                        delete i->Waiter;
-                    }
+        result = pthread_mutex_unlock(&event->Mutex);
+        assert(result == 0);
+        (void)result;
 
-                    event->RegisteredWaits.pop_front();
-                    continue;
-                }
+        return 0;
+    }
+
+    PEVENTS_INLINE int ResetEventShared(neosmart_event_shared_t event) {
+        int result = pthread_mutex_lock(&event->Mutex);
+        assert(result == 0);
+
+        event->State = false;
+
+        result = pthread_mutex_unlock(&event->Mutex);
+        assert(result == 0);
+        (void)result;
+
+        return 0;
+    }
+
+    PEVENTS_INLINE int DestroyEventShared(neosmart_event_shared_t event) {
+        // Spoil the magic first so a stale OpenEventShared() against the recycled region fails.
+        // Freeing (or unmapping) the region is the caller's business.
+        event->Magic.store(0, std::memory_order_relaxed);
+
+        int result = pthread_cond_destroy(&event->CVariable);
+        assert(result == 0);
+        result = pthread_mutex_destroy(&event->Mutex);
+        assert(result == 0);
+        (void)result;
+
+        return 0;
+    }
+
+#ifdef PULSE
+    PEVENTS_INLINE int PulseEvent(neosmart_event_t event) {
+        // A fused set-and-reset: the whole pulse — the registered-wait walk and the handoff to
+        // blocked single-event waiters — happens under one event mutex acquisition, and `State`
+        // is never published, so a wait beginning after the mutex is released cannot retroactively
+        // grab a pulse that was meant for threads already waiting. (The old SetEvent() +
+        // ResetEvent() sequence took the mutex twice and left exactly that window open.)
+        return SetEventInternal(event, nullptr, true);
+    }
+#endif
+
+#ifdef STATS
+    PEVENTS_INLINE int GetEventStats(neosmart_event_t event, neosmart_event_stats_t &stats) {
+        // Relaxed loads to match the relaxed increments; the snapshot is not atomic across
+        // fields, which is fine for a diagnostics surface.
+        stats.Waits = event->Stats.Waits.load(std::memory_order_relaxed);
+        stats.LockWaits = event->Stats.LockWaits.load(std::memory_order_relaxed);
+        stats.SpuriousWakeups = event->Stats.SpuriousWakeups.load(std::memory_order_relaxed);
+        stats.WaitersWoken = event->Stats.WaitersWoken.load(std::memory_order_relaxed);
+        stats.ExpiredWaits = event->Stats.ExpiredWaits.load(std::memory_order_relaxed);
+        return 0;
+    }
+#endif
+} // namespace neosmart
+#endif // FUTEX
+
+namespace neosmart {
+    // Waitable timers, shared by both backends. A single lazily-started service thread drives
+    // every timer in the process off a deadline-ordered min-heap, firing due timers through the
+    // ordinary SetEvent() machinery — so a timer handle is just an event, waitable alone or as
+    // part of any WFMO group, and one thread services thousands of timers. Arming pushes a heap
+    // record under the wheel mutex; re-arms and cancellations never touch the heap, they bump the
+    // timer's generation and let the service thread discard stale records as they surface.
+    struct neosmart_timer_t_ {
+        neosmart_event_t Event;
+        uint64_t Period; // milliseconds, 0 for a one-shot timer
+        // Bumped on every re-arm/cancel/destroy so records pushed before it are discarded
+        uint64_t Generation;
+        // Heap records still referencing this entry; the entry may only be freed at zero
+        int PendingRecords;
+        bool Armed;
+        bool Released;
+    };
+
+    struct neosmart_timer_record_t_ {
+        uint64_t Deadline; // absolute, on the CLOCK_MONOTONIC millisecond timeline
+        neosmart_timer_t_ *Timer;
+        uint64_t Generation;
+
+        bool operator>(const neosmart_timer_record_t_ &other) const {
+            return Deadline > other.Deadline;
+        }
+    };
+
+    typedef std::priority_queue<neosmart_timer_record_t_, std::vector<neosmart_timer_record_t_>,
+                                std::greater<neosmart_timer_record_t_>>
+        neosmart_timer_heap_t_;
+
+    static pthread_mutex_t TimerWheelMutex = PTHREAD_MUTEX_INITIALIZER;
+    static pthread_cond_t TimerWheelCVariable;
+    static pthread_once_t TimerWheelOnce = PTHREAD_ONCE_INIT;
+    // Heap-allocated (and deliberately never freed) so the detached service thread can't race
+    // static destruction at process exit
+    static neosmart_timer_heap_t_ *TimerWheelHeap;
+    static std::unordered_map<neosmart_event_t, neosmart_timer_t_ *> *TimerWheelTimers;
+    static bool TimerWheelRunning = false;
+
+    static uint64_t TimerWheelNow() {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / (1000 * 1000);
+    }
 
-                result = pthread_mutex_lock(&i->Waiter->Mutex);
-                assert(result == 0);
+    static void TimerWheelInit() {
+        // The condition variable waits on the monotonic clock, as elsewhere in the library
+#ifndef __APPLE__
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&TimerWheelCVariable, &attr);
+        pthread_condattr_destroy(&attr);
+#else
+        pthread_cond_init(&TimerWheelCVariable, nullptr);
+#endif
+        TimerWheelHeap = new neosmart_timer_heap_t_;
+        TimerWheelTimers = new std::unordered_map<neosmart_event_t, neosmart_timer_t_ *>;
+    }
 
-                // We have to check `Waiter->StillWaiting` twice, once before locking as an
-                // optimization to bypass the mutex altogether, and then again after locking the
-                // WFMO mutex because we could have !waitAll and another event could have ended the
-                // wait, in which case we must not unlock the same waiter or else a SetEvent() call
-                // on an auto-reset event may end up with a lost wakeup.
-                if (!i->Waiter->StillWaiting.load(std::memory_order_relaxed)) {
-                    result = pthread_mutex_unlock(&i->Waiter->Mutex);
-                    assert(result == 0);
+    // Sleeps (wheel mutex held) until `deadline` or until a new arming signals the wheel
+    static void TimerWheelSleepUntil(uint64_t deadline) {
+#ifdef __APPLE__
+        // Apple has no pthread_condattr_setclock(); wait a relative interval computed from the
+        // monotonic clock instead, mirroring TimedWait() in the pthread backend
+        uint64_t now = TimerWheelNow();
+        if (deadline <= now) {
+            return;
+        }
+        uint64_t remaining = deadline - now;
+        timespec interval = {(time_t)(remaining / 1000),
+                             (long)((remaining % 1000) * 1000 * 1000)};
+        pthread_cond_timedwait_relative_np(&TimerWheelCVariable, &TimerWheelMutex, &interval);
+#else
+        timespec until = {(time_t)(deadline / 1000), (long)((deadline % 1000) * 1000 * 1000)};
+        pthread_cond_timedwait(&TimerWheelCVariable, &TimerWheelMutex, &until);
+#endif
+    }
 
-                    // memory_order_seq_cst: Ensure this is run after the wfmo mutex is unlocked
-                    int ref_count = i->Waiter->RefCount.fetch_sub(1, std::memory_order_seq_cst);
-                    assert(ref_count > 0);
-                    if (ref_count == 1) {
-                        i->Waiter->Destroy();
-                        delete i->Waiter;
-                    }
+    static void *TimerWheelThread(void *) {
+        int result = pthread_mutex_lock(&TimerWheelMutex);
+        assert(result == 0);
+        (void)result;
 
-                    event->RegisteredWaits.pop_front();
-                    continue;
-                }
+        for (;;) {
+            if (TimerWheelHeap->empty()) {
+                pthread_cond_wait(&TimerWheelCVariable, &TimerWheelMutex);
+                continue;
+            }
 
-                if (i->Waiter->WaitAll) {
-                    --i->Waiter->Status.EventsLeft;
-                    assert(i->Waiter->Status.EventsLeft >= 0);
-                    // We technically should do i->Waiter->StillWaiting = Waiter->Status.EventsLeft
-                    // != 0 but the only time it'll be equal to zero is if we're the last event, so
-                    // no one else will be checking the StillWaiting flag. We're good to go without
-                    // it.
-                } else {
-                    i->Waiter->Status.FiredEvent = i->WaitIndex;
-                    // memory_order_relaxed: The flip to false is only lazily observed as an
-                    // optimization to bypass the mutex for cleanup.
-                    i->Waiter->StillWaiting.store(false, std::memory_order_relaxed);
+            neosmart_timer_record_t_ record = TimerWheelHeap->top();
+            if (record.Generation != record.Timer->Generation || !record.Timer->Armed) {
+                // Invalidated by a re-arm, cancel, or destroy since it was pushed
+                TimerWheelHeap->pop();
+                if (--record.Timer->PendingRecords == 0 && record.Timer->Released) {
+                    delete record.Timer;
                 }
+                continue;
+            }
 
-                result = pthread_mutex_unlock(&i->Waiter->Mutex);
-                assert(result == 0);
-
-                result = pthread_cond_signal(&i->Waiter->CVariable);
-                assert(result == 0);
+            uint64_t now = TimerWheelNow();
+            if (record.Deadline > now) {
+                TimerWheelSleepUntil(record.Deadline);
+                // An arming or cancellation may have changed the nearest deadline; re-evaluate
+                continue;
+            }
 
-                // memory_order_seq_cst: Ensure this is run after the wfmo mutex is unlocked
-                int ref_count = i->Waiter->RefCount.fetch_sub(1, std::memory_order_seq_cst);
-                assert(ref_count > 0);
-                if (ref_count == 1) {
-                    i->Waiter->Destroy();
-                    delete i->Waiter;
+            TimerWheelHeap->pop();
+            --record.Timer->PendingRecords;
+            if (record.Timer->Period != 0) {
+                // Drift-free periodic re-arm against the previous deadline; if the wheel fell
+                // behind by a full period or more, skip the missed firings rather than bursting
+                uint64_t next = record.Deadline + record.Timer->Period;
+                if (next <= now) {
+                    next = now + record.Timer->Period;
                 }
+                ++record.Timer->PendingRecords;
+                TimerWheelHeap->push({next, record.Timer, record.Generation});
+            } else {
+                record.Timer->Armed = false;
+            }
 
-                event->RegisteredWaits.pop_front();
+            // Fired with the wheel mutex still held: DestroyWaitableTimer() serializes on the
+            // wheel mutex, so the event cannot be destroyed out from under this call. Event code
+            // never takes the wheel mutex, so the wheel → event lock order is the only one.
+            SetEvent(record.Timer->Event);
+        }
 
-                result = pthread_mutex_unlock(&event->Mutex);
-                assert(result == 0);
+        return nullptr;
+    }
 
-                return 0;
-            }
-#endif // WFMO
-            // memory_order_release: this is the synchronization point for any threads spin-waiting
-            // for the event to become available.
-            event->State.store(true, std::memory_order_release);
+    PEVENTS_INLINE neosmart_event_t CreateWaitableTimer(uint64_t dueMilliseconds,
+                                                        uint64_t periodMilliseconds,
+                                                        bool manualReset) {
+        neosmart_event_t event = CreateEvent(manualReset, false, false);
 
-            result = pthread_mutex_unlock(&event->Mutex);
-            assert(result == 0);
+        pthread_once(&TimerWheelOnce, TimerWheelInit);
+        int result = pthread_mutex_lock(&TimerWheelMutex);
+        assert(result == 0);
 
-            result = pthread_cond_signal(&event->CVariable);
+        neosmart_timer_t_ *timer = new neosmart_timer_t_;
+        timer->Event = event;
+        timer->Period = periodMilliseconds;
+        timer->Generation = 0;
+        timer->PendingRecords = 1;
+        timer->Armed = true;
+        timer->Released = false;
+        (*TimerWheelTimers)[event] = timer;
+        TimerWheelHeap->push({TimerWheelNow() + dueMilliseconds, timer, timer->Generation});
+
+        if (!TimerWheelRunning) {
+            pthread_t thread;
+            result = pthread_create(&thread, nullptr, TimerWheelThread, nullptr);
             assert(result == 0);
+            pthread_detach(thread);
+            TimerWheelRunning = true;
+        }
 
-            return 0;
-        } else { // this is a manual reset event
-            // memory_order_release: this is the synchronization point for any threads spin-waiting
-            // for the event to become available.
-            event->State.store(true, std::memory_order_release);
-#ifdef WFMO
-            for (size_t i = 0; i < event->RegisteredWaits.size(); ++i) {
-                neosmart_wfmo_info_t info = &event->RegisteredWaits[i];
+        result = pthread_cond_signal(&TimerWheelCVariable);
+        assert(result == 0);
+        result = pthread_mutex_unlock(&TimerWheelMutex);
+        assert(result == 0);
 
-                // memory_order_relaxed: this is just an optimization to see if it is OK to skip
-                // this waiter, and if it's observed to be false then it's OK to bypass the mutex at
-                // that point.
-                if (!info->Waiter->StillWaiting.load(std::memory_order_relaxed)) {
-                    int ref_count = info->Waiter->RefCount.fetch_sub(1, std::memory_order_acq_rel);
-                    if (ref_count == 1) {
-                        info->Waiter->Destroy();
-                        delete info->Waiter;
-                    }
-                    continue;
-                }
+        return event;
+    }
 
-                result = pthread_mutex_lock(&info->Waiter->Mutex);
-                assert(result == 0);
+    PEVENTS_INLINE int SetWaitableTimer(neosmart_event_t timer, uint64_t dueMilliseconds,
+                                        uint64_t periodMilliseconds) {
+        pthread_once(&TimerWheelOnce, TimerWheelInit);
+        int result = pthread_mutex_lock(&TimerWheelMutex);
+        assert(result == 0);
 
-                // Waiter->StillWaiting may have become true by now, but we're just going to pretend
-                // it hasn't. So long as we hold a reference to the WFMO, this is safe since manual
-                // reset events are not one-time use.
+        auto found = TimerWheelTimers->find(timer);
+        if (found == TimerWheelTimers->end()) {
+            result = pthread_mutex_unlock(&TimerWheelMutex);
+            assert(result == 0);
+            return EINVAL;
+        }
 
-                if (info->Waiter->WaitAll) {
-                    --info->Waiter->Status.EventsLeft;
-                    assert(info->Waiter->Status.EventsLeft >= 0);
-                    // We technically should do i->Waiter->StillWaiting = Waiter->Status.EventsLeft
-                    // != 0 but the only time it'll be equal to zero is if we're the last event, so
-                    // no one else will be checking the StillWaiting flag. We're good to go without
-                    // it.
-                } else {
-                    info->Waiter->Status.FiredEvent = info->WaitIndex;
-                    // memory_order_relaxed: The flip to false is only lazily observed as an
-                    // optimization to bypass the mutex for cleanup.
-                    info->Waiter->StillWaiting.store(false, std::memory_order_relaxed);
-                }
+        neosmart_timer_t_ *entry = found->second;
+        ++entry->Generation;
+        entry->Period = periodMilliseconds;
+        entry->Armed = true;
+        ++entry->PendingRecords;
+        TimerWheelHeap->push({TimerWheelNow() + dueMilliseconds, entry, entry->Generation});
 
-                result = pthread_mutex_unlock(&info->Waiter->Mutex);
-                assert(result == 0);
+        result = pthread_cond_signal(&TimerWheelCVariable);
+        assert(result == 0);
+        result = pthread_mutex_unlock(&TimerWheelMutex);
+        assert(result == 0);
 
-                result = pthread_cond_signal(&info->Waiter->CVariable);
-                assert(result == 0);
+        return 0;
+    }
 
-                // memory_order_seq_cst: Ensure this is run after the wfmo mutex is unlocked
-                int ref_count = info->Waiter->RefCount.fetch_sub(1, std::memory_order_seq_cst);
-                assert(ref_count > 0);
-                if (ref_count == 1) {
-                    info->Waiter->Destroy();
-                    delete info->Waiter;
-                }
-                continue;
-            }
-            event->RegisteredWaits.clear();
-#endif // WFMO
-            result = pthread_mutex_unlock(&event->Mutex);
-            assert(result == 0);
+    PEVENTS_INLINE int CancelWaitableTimer(neosmart_event_t timer) {
+        pthread_once(&TimerWheelOnce, TimerWheelInit);
+        int result = pthread_mutex_lock(&TimerWheelMutex);
+        assert(result == 0);
 
-            result = pthread_cond_broadcast(&event->CVariable);
+        auto found = TimerWheelTimers->find(timer);
+        if (found == TimerWheelTimers->end()) {
+            result = pthread_mutex_unlock(&TimerWheelMutex);
             assert(result == 0);
+            return EINVAL;
         }
 
-        return 0;
-    }
+        // The stale records drain lazily; no need to wake the wheel just to discard them early
+        ++found->second->Generation;
+        found->second->Armed = false;
+
+        result = pthread_mutex_unlock(&TimerWheelMutex);
+        assert(result == 0);
 
-    int ResetEvent(neosmart_event_t event) {
-        // memory_order_relaxed and no mutex: there can't be any guarantees about concurrent calls
-        // to either of WFMO()/SetEvent() and ResetEvent() because they're racy by nature. Only the
-        // behavior of concurrent WFMO() and SetEvent() calls is strongly defined.
-        event->State.store(false, std::memory_order_relaxed);
         return 0;
     }
 
-#ifdef PULSE
-    int PulseEvent(neosmart_event_t event) {
-        // This may look like it's a horribly inefficient kludge with the sole intention of reducing
-        // code duplication, but in reality this is what any PulseEvent() implementation must look
-        // like. The only overhead (function calls aside, which your compiler will likely optimize
-        // away, anyway), is if only WFMO auto-reset waits are active there will be overhead to
-        // unnecessarily obtain the event mutex for ResetEvent() after. In all other cases (being no
-        // pending waits, WFMO manual-reset waits, or any WFSO waits), the event mutex must first be
-        // released for the waiting thread to resume action prior to locking the mutex again in
-        // order to set the event state to unsignaled, or else the waiting threads will loop back
-        // into a wait (due to checks for spurious CVariable wakeups).
-
-        int result = SetEvent(event);
+    PEVENTS_INLINE int DestroyWaitableTimer(neosmart_event_t timer) {
+        pthread_once(&TimerWheelOnce, TimerWheelInit);
+        int result = pthread_mutex_lock(&TimerWheelMutex);
         assert(result == 0);
-        result = ResetEvent(event);
+
+        auto found = TimerWheelTimers->find(timer);
+        if (found == TimerWheelTimers->end()) {
+            result = pthread_mutex_unlock(&TimerWheelMutex);
+            assert(result == 0);
+            return EINVAL;
+        }
+
+        neosmart_timer_t_ *entry = found->second;
+        TimerWheelTimers->erase(found);
+        ++entry->Generation;
+        entry->Armed = false;
+        entry->Released = true;
+        if (entry->PendingRecords == 0) {
+            delete entry;
+        }
+
+        result = pthread_mutex_unlock(&TimerWheelMutex);
         assert(result == 0);
 
-        return 0;
+        // Safe once the wheel mutex is dropped: the wheel only fires events while holding it,
+        // and every remaining record for this timer now fails the generation check
+        return DestroyEvent(timer);
     }
-#endif
 } // namespace neosmart
 
 #else // _WIN32
 
 #include <Windows.h>
 #include "pevents.h"
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <vector>
 
 namespace neosmart {
-    neosmart_event_t CreateEvent(bool manualReset, bool initialState) {
+    PEVENTS_INLINE neosmart_event_t CreateEvent(bool manualReset, bool initialState, bool /*spinWait*/) {
+        // The kernel already employs its own adaptive strategies here; the spin-wait hint has no
+        // Windows equivalent and is ignored.
         return static_cast<neosmart_event_t>(::CreateEvent(NULL, manualReset, initialState, NULL));
     }
 
-    int DestroyEvent(neosmart_event_t event) {
+    PEVENTS_INLINE neosmart_event_t CreateCountedEvent(int initialCount, bool /*spinWait*/) {
+        // A counted event maps directly onto a kernel semaphore; note that SetEvent()/
+        // ResetEvent() cannot be used against it here — signal with ReleaseEvent() instead.
+        return static_cast<neosmart_event_t>(::CreateSemaphore(NULL, initialCount, LONG_MAX, NULL));
+    }
+
+    PEVENTS_INLINE int ReleaseEvent(neosmart_event_t event, int count) {
+        if (count < 0) {
+            return EINVAL;
+        }
+        if (count == 0) {
+            return 0;
+        }
+        HANDLE handle = static_cast<HANDLE>(event);
+        return ReleaseSemaphore(handle, count, NULL) ? 0 : GetLastError();
+    }
+
+    PEVENTS_INLINE int DestroyEvent(neosmart_event_t event) {
         HANDLE handle = static_cast<HANDLE>(event);
         return CloseHandle(handle) ? 0 : GetLastError();
     }
 
-    int WaitForEvent(neosmart_event_t event, uint64_t milliseconds) {
+    PEVENTS_INLINE int CreateEventArray(neosmart_event_t *out, int count, bool manualReset,
+                                        bool initialState) {
+        // Kernel event objects aren't ours to lay out, so there is no arena here — this is bulk
+        // creation (and bulk cleanup on failure) only.
+        for (int i = 0; i < count; ++i) {
+            out[i] = CreateEvent(manualReset, initialState, false);
+            if (out[i] == nullptr) {
+                int result = GetLastError();
+                while (i-- > 0) {
+                    DestroyEvent(out[i]);
+                }
+                return result;
+            }
+        }
+        return 0;
+    }
+
+    PEVENTS_INLINE int DestroyEventArray(neosmart_event_t *events, int count) {
+        int result = 0;
+        for (int i = 0; i < count; ++i) {
+            int destroyResult = DestroyEvent(events[i]);
+            if (destroyResult != 0) {
+                result = destroyResult;
+            }
+        }
+        return result;
+    }
+
+    PEVENTS_INLINE int WaitForEvent(neosmart_event_t event, uint64_t milliseconds) {
         uint32_t result = 0;
         HANDLE handle = static_cast<HANDLE>(event);
 
@@ -600,25 +3579,263 @@ namespace neosmart {
         return GetLastError();
     }
 
-    int SetEvent(neosmart_event_t event) {
+    PEVENTS_INLINE int SetEvent(neosmart_event_t event) {
         HANDLE handle = static_cast<HANDLE>(event);
         return ::SetEvent(handle) ? 0 : GetLastError();
     }
 
-    int ResetEvent(neosmart_event_t event) {
+    PEVENTS_INLINE int SetEvents(neosmart_event_t *events, int count) {
+        // There is no userspace batching to be had against the kernel's event objects; signal
+        // each in turn.
+        for (int i = 0; i < count; ++i) {
+            int result = SetEvent(events[i]);
+            if (result != 0) {
+                return result;
+            }
+        }
+        return 0;
+    }
+
+    PEVENTS_INLINE int ResetEvent(neosmart_event_t event) {
         HANDLE handle = static_cast<HANDLE>(event);
         return ::ResetEvent(handle) ? 0 : GetLastError();
     }
 
 #ifdef WFMO
-    int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+    // Clamp a 64-bit remaining-time figure to one WaitForXxxObject(s) call's 32-bit timeout
+    // (0xFFFFFFFF means infinity to WIN32, so cap one notch below it)
+    static DWORD ClampWaitUnit(uint64_t remaining) {
+        const uint32_t waitUnit = static_cast<uint32_t>(WAIT_INFINITE) - 1;
+        return remaining > waitUnit ? waitUnit : static_cast<DWORD>(remaining);
+    }
+
+    // WaitForMultipleObjects() hard-fails above MAXIMUM_WAIT_OBJECTS (64) handles, while the
+    // POSIX implementation takes any count; waits wider than that are transparently chunked so
+    // the same application code runs on both platforms.
+    //
+    // Wait-any demultiplexes through a cached pool of helper waiter threads: each helper waits
+    // (infinitely) on a cancel event plus up to 63 of the caller's handles and reports through a
+    // completion semaphore, and the first helper to claim a real signal decides the wait. The
+    // helpers and their kernel objects persist in the pool across calls, so a steady-state wide
+    // wait costs assignment handoffs rather than thread creation. A helper that consumed a
+    // signal but lost the claim race re-signals the handle; as with the timeout re-publication
+    // below, that is best-effort for counted events (kernel semaphores reject ::SetEvent()).
+    struct neosmart_chunk_waiter_t_ {
+        HANDLE Thread;
+        HANDLE Assigned; // auto-reset: a new assignment is ready for this helper
+        // The assignment, owned by the master between SetEvent(Assigned) and the completion
+        // report; Handles[0] is always the master's cancel event
+        HANDLE *Handles;
+        int Count;
+        int Base; // index of Handles[1] within the caller's event array
+        HANDLE Completions;
+        volatile LONG *Winner;
+        DWORD Error;
+        neosmart_chunk_waiter_t_ *Next;
+    };
+
+    static SRWLOCK ChunkPoolLock = SRWLOCK_INIT;
+    static neosmart_chunk_waiter_t_ *ChunkPoolHead = nullptr;
+
+    static DWORD WINAPI ChunkWaiterThread(void *parameter) {
+        neosmart_chunk_waiter_t_ *waiter = static_cast<neosmart_chunk_waiter_t_ *>(parameter);
+        for (;;) {
+            WaitForSingleObject(waiter->Assigned, INFINITE);
+
+            DWORD result = WaitForMultipleObjects(waiter->Count, waiter->Handles, FALSE, INFINITE);
+            int fired = -1;
+            if (result >= WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + (DWORD)waiter->Count) {
+                fired = result - WAIT_OBJECT_0;
+            } else if (result >= WAIT_ABANDONED_0 &&
+                       result < WAIT_ABANDONED_0 + (DWORD)waiter->Count) {
+                fired = result - WAIT_ABANDONED_0;
+            }
+
+            if (fired > 0) {
+                // A real signal (not the cancel slot): first claimant decides the wait; a loser
+                // consumed a signal that wasn't needed and re-publishes it (best effort)
+                LONG claim = static_cast<LONG>(waiter->Base + fired - 1);
+                if (InterlockedCompareExchange(waiter->Winner, claim, -1) != -1) {
+                    ::SetEvent(waiter->Handles[fired]);
+                }
+            } else if (fired < 0) {
+                waiter->Error = GetLastError();
+            }
+
+            // Exactly one completion per assignment; a semaphore because auto-reset events
+            // coalesce back-to-back signals and the master counts these
+            ReleaseSemaphore(waiter->Completions, 1, NULL);
+        }
+        return 0;
+    }
+
+    static neosmart_chunk_waiter_t_ *AcquireChunkWaiter() {
+        AcquireSRWLockExclusive(&ChunkPoolLock);
+        neosmart_chunk_waiter_t_ *waiter = ChunkPoolHead;
+        if (waiter != nullptr) {
+            ChunkPoolHead = waiter->Next;
+        }
+        ReleaseSRWLockExclusive(&ChunkPoolLock);
+
+        if (waiter == nullptr) {
+            waiter = new neosmart_chunk_waiter_t_;
+            waiter->Assigned = ::CreateEvent(NULL, FALSE, FALSE, NULL);
+            waiter->Thread = CreateThread(NULL, 0, ChunkWaiterThread, waiter, 0, NULL);
+        }
+        return waiter;
+    }
+
+    static void ReleaseChunkWaiter(neosmart_chunk_waiter_t_ *waiter) {
+        AcquireSRWLockExclusive(&ChunkPoolLock);
+        waiter->Next = ChunkPoolHead;
+        ChunkPoolHead = waiter;
+        ReleaseSRWLockExclusive(&ChunkPoolLock);
+    }
+
+    static int WaitAnyChunked(neosmart_event_t *events, int count, uint64_t milliseconds,
+                              int &index) {
+        const int chunkCapacity = MAXIMUM_WAIT_OBJECTS - 1; // one slot per chunk for cancel
+        int chunks = (count + chunkCapacity - 1) / chunkCapacity;
+
+        HANDLE completions = ::CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+        HANDLE cancel = ::CreateEvent(NULL, TRUE, FALSE, NULL);
+        volatile LONG winner = -1;
+
+        std::vector<HANDLE> handles(chunks * MAXIMUM_WAIT_OBJECTS);
+        std::vector<neosmart_chunk_waiter_t_ *> waiters(chunks);
+        for (int c = 0; c < chunks; ++c) {
+            int base = c * chunkCapacity;
+            int n = count - base < chunkCapacity ? count - base : chunkCapacity;
+            HANDLE *chunk = &handles[c * MAXIMUM_WAIT_OBJECTS];
+            chunk[0] = cancel;
+            for (int i = 0; i < n; ++i) {
+                chunk[1 + i] = static_cast<HANDLE>(events[base + i]);
+            }
+
+            neosmart_chunk_waiter_t_ *waiter = AcquireChunkWaiter();
+            waiter->Handles = chunk;
+            waiter->Count = 1 + n;
+            waiter->Base = base;
+            waiter->Completions = completions;
+            waiter->Winner = &winner;
+            waiter->Error = 0;
+            waiters[c] = waiter;
+            ::SetEvent(waiter->Assigned);
+        }
+
+        // Until the cancel event is set, a helper only completes on a claimed/lost signal or an
+        // error — so the first completion (within the timeout) decides the wait
+        int result = WAIT_TIMEOUT;
+        int completed = 0;
+        uint64_t deadline = milliseconds == WAIT_INFINITE ? 0 : GetTickCount64() + milliseconds;
+        for (;;) {
+            DWORD wait;
+            if (milliseconds == WAIT_INFINITE) {
+                wait = WaitForSingleObject(completions, INFINITE);
+            } else {
+                uint64_t now = GetTickCount64();
+                wait = WaitForSingleObject(completions,
+                                           now < deadline ? ClampWaitUnit(deadline - now) : 0);
+            }
+            if (wait == WAIT_TIMEOUT) {
+                if (milliseconds != WAIT_INFINITE && GetTickCount64() < deadline) {
+                    continue; // Only a 32-bit slice of a >49-day timeout expired
+                }
+                result = WAIT_TIMEOUT;
+                break;
+            }
+            ++completed;
+            if (winner != -1) {
+                result = 0;
+                break;
+            }
+            // A completion with no winner is a helper reporting failure
+            result = WAIT_FAILED;
+            break;
+        }
+
+        // Release the remaining helpers and drain every outstanding completion before the
+        // assignment buffers and the cancel event can be torn down or the helpers reused
+        ::SetEvent(cancel);
+        while (completed < chunks) {
+            WaitForSingleObject(completions, INFINITE);
+            ++completed;
+        }
+        for (int c = 0; c < chunks; ++c) {
+            if (result == WAIT_FAILED && waiters[c]->Error != 0) {
+                result = waiters[c]->Error;
+            }
+            ReleaseChunkWaiter(waiters[c]);
+        }
+        CloseHandle(cancel);
+        CloseHandle(completions);
+
+        if (result == 0) {
+            index = static_cast<int>(winner);
+        }
+        return result;
+    }
+
+    // Wait-all needs no helpers: each chunk is awaited in turn against the remaining time, since
+    // every chunk must be satisfied regardless of order. Kernel atomicity holds within a chunk
+    // but not across chunks; mirroring the POSIX implementation, a timed-out wait re-publishes
+    // the signals the already-completed chunks consumed (best effort — counted events are
+    // kernel semaphores and cannot be re-signaled with ::SetEvent(); re-signaling a still-set
+    // manual-reset event is a no-op).
+    static int WaitAllChunked(neosmart_event_t *events, int count, uint64_t milliseconds) {
+        HANDLE *handles = reinterpret_cast<HANDLE *>(events);
+        uint64_t deadline = milliseconds == WAIT_INFINITE ? 0 : GetTickCount64() + milliseconds;
+
+        for (int base = 0; base < count; base += MAXIMUM_WAIT_OBJECTS) {
+            int n = count - base < MAXIMUM_WAIT_OBJECTS ? count - base : MAXIMUM_WAIT_OBJECTS;
+
+            DWORD result;
+            for (;;) {
+                DWORD wait;
+                if (milliseconds == WAIT_INFINITE) {
+                    wait = INFINITE;
+                } else {
+                    uint64_t now = GetTickCount64();
+                    wait = now < deadline ? ClampWaitUnit(deadline - now) : 0;
+                }
+                result = WaitForMultipleObjects(n, handles + base, TRUE, wait);
+                if (result == WAIT_TIMEOUT && milliseconds != WAIT_INFINITE &&
+                    GetTickCount64() < deadline) {
+                    continue; // Only a 32-bit slice of a >49-day timeout expired
+                }
+                break;
+            }
+
+            if (result == WAIT_TIMEOUT || result == WAIT_FAILED) {
+                DWORD error = result == WAIT_FAILED ? GetLastError() : 0;
+                for (int i = 0; i < base; ++i) {
+                    ::SetEvent(handles[i]);
+                }
+                return result == WAIT_TIMEOUT ? WAIT_TIMEOUT : static_cast<int>(error);
+            }
+        }
+        return 0;
+    }
+
+    PEVENTS_INLINE int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
                               uint64_t milliseconds) {
         int index = 0;
         return WaitForMultipleEvents(events, count, waitAll, milliseconds, index);
     }
 
-    int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+    PEVENTS_INLINE int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
                               uint64_t milliseconds, int &index) {
+        if (count > MAXIMUM_WAIT_OBJECTS) {
+            if (waitAll) {
+                int result = WaitAllChunked(events, count, milliseconds);
+                if (result == 0) {
+                    index = 0;
+                }
+                return result;
+            }
+            return WaitAnyChunked(events, count, milliseconds, index);
+        }
+
         HANDLE *handles = reinterpret_cast<HANDLE *>(events);
         uint32_t result = 0;
 
@@ -651,14 +3868,99 @@ namespace neosmart {
         }
         return result;
     }
+
+    PEVENTS_INLINE int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+                              uint64_t milliseconds, int *signaled, int &signaledCount) {
+        signaledCount = 0;
+
+        int index = -1;
+        int result = WaitForMultipleEvents(events, count, waitAll, milliseconds, index);
+        if (result != 0) {
+            return result;
+        }
+
+        // Sweep whatever else is signaled right now with zero-timeout single waits, which
+        // consume per each event's reset semantics just like the fired event's wait did.
+        for (int i = 0; i < count; ++i) {
+            if (waitAll || i == index || WaitForEvent(events[i], 0) == 0) {
+                signaled[signaledCount++] = i;
+            }
+        }
+
+        return 0;
+    }
+
+    PEVENTS_INLINE int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+                              uint64_t milliseconds, uint64_t &signaledMask) {
+        // One mask bit per event; use the index-span overload for larger groups
+        assert(count <= 64);
+
+        int signaled[64];
+        int signaledCount = 0;
+        signaledMask = 0;
+
+        int result =
+            WaitForMultipleEvents(events, count, waitAll, milliseconds, signaled, signaledCount);
+        if (result != 0) {
+            return result;
+        }
+
+        for (int i = 0; i < signaledCount; ++i) {
+            signaledMask |= (uint64_t)1 << signaled[i];
+        }
+
+        return 0;
+    }
+
+    // Windows kernel events don't have per-wait registration costs to amortize, so a wait-set is
+    // just a snapshot of the handles passed straight through to WaitForMultipleObjects().
+    struct neosmart_waitset_t_ {
+        neosmart_event_t *Events;
+        int Count;
+    };
+
+    PEVENTS_INLINE neosmart_waitset_t CreateWaitSet(neosmart_event_t *events, int count) {
+        neosmart_waitset_t waitset = new neosmart_waitset_t_;
+        waitset->Events = new neosmart_event_t[count];
+        waitset->Count = count;
+        for (int i = 0; i < count; ++i) {
+            waitset->Events[i] = events[i];
+        }
+        return waitset;
+    }
+
+    PEVENTS_INLINE int WaitForWaitSet(neosmart_waitset_t waitset, bool waitAll, uint64_t milliseconds) {
+        return WaitForMultipleEvents(waitset->Events, waitset->Count, waitAll, milliseconds);
+    }
+
+    PEVENTS_INLINE int WaitForWaitSet(neosmart_waitset_t waitset, bool waitAll, uint64_t milliseconds,
+                       int &index) {
+        return WaitForMultipleEvents(waitset->Events, waitset->Count, waitAll, milliseconds,
+                                     index);
+    }
+
+    PEVENTS_INLINE int DestroyWaitSet(neosmart_waitset_t waitset) {
+        delete[] waitset->Events;
+        delete waitset;
+        return 0;
+    }
 #endif
 
 #ifdef PULSE
-    int PulseEvent(neosmart_event_t event) {
+    PEVENTS_INLINE int PulseEvent(neosmart_event_t event) {
         HANDLE handle = static_cast<HANDLE>(event);
         return ::PulseEvent(handle) ? 0 : GetLastError();
     }
 #endif
+
+#ifdef STATS
+    PEVENTS_INLINE int GetEventStats(neosmart_event_t /*event*/, neosmart_event_stats_t &stats) {
+        // Kernel event objects expose none of these internals; report a zeroed snapshot so code
+        // written against the instrumentation surface still compiles and runs.
+        stats = neosmart_event_stats_t();
+        return 0;
+    }
+#endif
 } // namespace neosmart
 
 #endif //_WIN32
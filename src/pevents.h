@@ -15,29 +15,283 @@
 #define WAIT_TIMEOUT ETIMEDOUT
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+#if defined(CORO) && defined(__cpp_impl_coroutine)
+#include <coroutine>
+#endif
+
+// When the concatenated single-header build (pevents.hpp) is included with PEVENTS_HEADER_ONLY
+// defined, the implementation is emitted inline into every including translation unit: feature
+// selection (WFMO/PULSE/...) becomes a per-build compile-time specialization — events compiled
+// without WFMO carry none of the multi-wait bookkeeping members — and the hot-path functions can
+// inline straight into callers. All translation units linked into one binary must use identical
+// pevents feature macros. Without PEVENTS_HEADER_ONLY, nothing changes.
+#ifdef PEVENTS_HEADER_ONLY
+#define PEVENTS_INLINE inline
+#else
+#define PEVENTS_INLINE
+#endif
 
 namespace neosmart {
     // Type declarations
     struct neosmart_event_t_;
     typedef neosmart_event_t_ *neosmart_event_t;
+#ifdef WFMO
+    struct neosmart_waitset_t_;
+    typedef neosmart_waitset_t_ *neosmart_waitset_t;
+#ifndef _WIN32
+    struct neosmart_port_t_;
+    typedef neosmart_port_t_ *neosmart_port_t;
+    struct neosmart_eventgroup_t_;
+    typedef neosmart_eventgroup_t_ *neosmart_eventgroup_t;
+#endif
+#endif
 
     // Constant declarations
     const uint64_t WAIT_INFINITE = ~((uint64_t)0);
 
     // Function declarations
-    neosmart_event_t CreateEvent(bool manualReset = false, bool initialState = false);
+    // `spinWait` opts the event into an adaptive spin-before-block wait strategy, intended for
+    // events that are typically signaled within a few microseconds of the wait beginning.
+    neosmart_event_t CreateEvent(bool manualReset = false, bool initialState = false,
+                                 bool spinWait = false);
     int DestroyEvent(neosmart_event_t event);
+    // Bulk construction: fills `out` with `count` events carved out of one aligned arena, each
+    // padded to its own cache line(s), so hot neighboring events can't false-share and the block
+    // costs a single allocation. The whole block shares one lifetime — destroy it only (and all
+    // at once) with DestroyEventArray(), never with DestroyEvent(). On Windows the events are
+    // ordinary kernel objects and the pair is just bulk create/destroy.
+    int CreateEventArray(neosmart_event_t *out, int count, bool manualReset = false,
+                         bool initialState = false);
+    int DestroyEventArray(neosmart_event_t *events, int count);
+    // A counted (semaphore-style) event: WaitForEvent() consumes one unit of the count and only
+    // blocks while the count is zero; ReleaseEvent() adds `count` units, waking up to that many
+    // waiters under a single lock acquisition with one coalesced notification. SetEvent() on a
+    // counted event releases a single unit (except on Windows, where counted events are kernel
+    // semaphores and must be signaled with ReleaseEvent()).
+    neosmart_event_t CreateCountedEvent(int initialCount = 0, bool spinWait = false);
+    int ReleaseEvent(neosmart_event_t event, int count);
     int WaitForEvent(neosmart_event_t event, uint64_t milliseconds = WAIT_INFINITE);
     int SetEvent(neosmart_event_t event);
+    int SetEvents(neosmart_event_t *events, int count);
     int ResetEvent(neosmart_event_t event);
+#ifndef _WIN32
+    // Recycling create/destroy for short-lived events: RecycleEvent() scrubs the event (state
+    // cleared, expired registrations swept, any attached fd drained but kept) and parks it —
+    // mutex and condition variable still initialized — in a per-thread cache with a bounded
+    // global overflow, and CreateEventCached() reuses a parked event instead of paying the
+    // allocator and pthread init costs. The pair is otherwise interchangeable with
+    // CreateEvent()/DestroyEvent(): either destroy call works on either event, but only
+    // RecycleEvent() feeds the cache. Not for counted events or CreateEventArray() members.
+    neosmart_event_t CreateEventCached(bool manualReset = false, bool initialState = false,
+                                       bool spinWait = false);
+    int RecycleEvent(neosmart_event_t event);
+
+    // Deadline form of WaitForEvent(): `deadline` is an absolute CLOCK_MONOTONIC time, handed
+    // straight to the underlying timed wait. A caller looping over several waits (retry loops,
+    // schedulers draining until a tick) computes the deadline once instead of paying a clock
+    // read per call, and the overall deadline holds exactly however many times the wait is
+    // re-entered. A deadline already in the past behaves like a zero-millisecond wait.
+    int WaitForEventUntil(neosmart_event_t event, const timespec &deadline);
+    // Cross-process events living in caller-provided shared memory (at least EventSharedSize()
+    // bytes, suitably aligned — e.g. the start of an mmap'd region). CreateEventShared()
+    // placement-constructs the event with PTHREAD_PROCESS_SHARED primitives (the futex backend
+    // uses the futex word directly); OpenEventShared() attaches to an event another process
+    // already constructed there. The layout holds only fixed-size fields, but all participating
+    // processes must share an architecture and libc. Shared events support the plain signal/wait
+    // calls below; they cannot participate in WFMO, wait-sets, or ports. DestroyEventShared()
+    // tears down the primitives without freeing the caller's region; call it once, after all
+    // processes are done with the event. On Windows, use named kernel events instead.
+    struct neosmart_event_shared_t_;
+    typedef neosmart_event_shared_t_ *neosmart_event_shared_t;
+    size_t EventSharedSize();
+    neosmart_event_shared_t CreateEventShared(void *region, bool manualReset = false,
+                                              bool initialState = false);
+    neosmart_event_shared_t OpenEventShared(void *region);
+    int WaitForEventShared(neosmart_event_shared_t event, uint64_t milliseconds = WAIT_INFINITE);
+    int SetEventShared(neosmart_event_shared_t event);
+    int ResetEventShared(neosmart_event_shared_t event);
+    int DestroyEventShared(neosmart_event_shared_t event);
+
+    // Lazily attaches a pollable file descriptor (a Linux eventfd, or a self-pipe elsewhere) to
+    // the event and returns it, so the event can be monitored from an epoll/poll/kqueue loop
+    // without a bridging thread. The fd polls readable exactly while the event is signaled; do
+    // not read from or close it directly — consume the event with WaitForEvent() (which also
+    // clears the fd for auto-reset events) and let DestroyEvent() close it. Returns -1 on
+    // failure. On Windows the event handle itself is already waitable.
+    int GetEventFd(neosmart_event_t event);
+
+    // A WIN32-style waitable timer: the returned handle is an ordinary event, waitable alone or
+    // as part of any WFMO group, that a single lazily-started internal service thread signals
+    // (via the normal SetEvent() machinery) `dueMilliseconds` after creation and, if
+    // `periodMilliseconds` is non-zero, every period thereafter — one thread services every
+    // timer in the process, and arming costs one heap push. An auto-reset timer releases one
+    // waiter per firing; a manual-reset timer latches until ResetEvent(). SetWaitableTimer()
+    // re-arms (superseding any pending firing) and CancelWaitableTimer() disarms without
+    // destroying the handle. Destroy timers only with DestroyWaitableTimer(), never with
+    // DestroyEvent(). On Windows, use native kernel waitable timers instead.
+    neosmart_event_t CreateWaitableTimer(uint64_t dueMilliseconds, uint64_t periodMilliseconds = 0,
+                                         bool manualReset = false);
+    int SetWaitableTimer(neosmart_event_t timer, uint64_t dueMilliseconds,
+                         uint64_t periodMilliseconds = 0);
+    int CancelWaitableTimer(neosmart_event_t timer);
+    int DestroyWaitableTimer(neosmart_event_t timer);
+#endif
 #ifdef WFMO
     int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
                               uint64_t milliseconds);
     int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
                               uint64_t milliseconds, int &index);
+#ifndef _WIN32
+    // Deadline forms of WaitForMultipleEvents(); see WaitForEventUntil() above.
+    int WaitForMultipleEventsUntil(neosmart_event_t *events, int count, bool waitAll,
+                                   const timespec &deadline);
+    int WaitForMultipleEventsUntil(neosmart_event_t *events, int count, bool waitAll,
+                                   const timespec &deadline, int &index);
+    // Prioritized waits: each event keeps its registered waits ordered by descending priority
+    // (FIFO among equal priorities, so waits that don't opt in — priority 0 — behave exactly as
+    // before), and an auto-reset signal is handed to the highest-priority registered waiter
+    // first. Negative priorities rank below the default. A prioritized single-event wait is
+    // routed through the registration machinery (plain condition-variable waiters can't be
+    // woken selectively) and so pays the registration cost; note that registered waiters of any
+    // priority are always serviced ahead of plain WaitForEvent() callers.
+    int WaitForEvent(neosmart_event_t event, uint64_t milliseconds, int priority);
+    int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+                              uint64_t milliseconds, int &index, int priority);
+#endif
+    // Burst-draining variants: once the wait completes, every event that is signaled at that
+    // moment is opportunistically consumed (honoring each event's reset/count semantics) in the
+    // same pass, amortizing one registration pass over many ready events. The mask form reports
+    // one bit per event index and requires count <= 64; the span form fills `signaled` (which
+    // must hold at least `count` entries) with the consumed indices in ascending order.
+    int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+                              uint64_t milliseconds, uint64_t &signaledMask);
+    int WaitForMultipleEvents(neosmart_event_t *events, int count, bool waitAll,
+                              uint64_t milliseconds, int *signaled, int &signaledCount);
+    // A wait-set registers with its events once up-front so that repeated multi-event waits
+    // against the same group of events don't pay the per-event registration cost each time.
+    // A wait-set may only be waited on by one thread at a time, and the events it contains must
+    // outlive it (destroy the wait-set before destroying any of its events).
+#ifndef _WIN32
+    // A bulk-created event group with a packed readiness bitmap: the events are laid out as by
+    // CreateEventArray() (and are ordinary events, usable individually or in any WFMO call)
+    // while SetEvent()/ResetEvent() additionally mirror each member's signaled state into one
+    // contiguous bit per event. WaitForEventGroup() then finds every signaled member with a
+    // handful of 64-bit word reads — for a 200-event group, four sequential loads instead of
+    // 200 dependent cache misses — and only touches the event structures it actually claims or
+    // registers with. `out` receives the member events, in bit order; the mask form reports one
+    // bit per member and requires count <= 64. The whole group shares one lifetime — destroy it
+    // only (and all at once) with DestroyEventGroup().
+    neosmart_eventgroup_t CreateEventGroup(neosmart_event_t *out, int count,
+                                           bool manualReset = false, bool initialState = false);
+    int WaitForEventGroup(neosmart_eventgroup_t group, bool waitAll, uint64_t milliseconds,
+                          int &index);
+    int WaitForEventGroup(neosmart_eventgroup_t group, bool waitAll, uint64_t milliseconds,
+                          uint64_t &signaledMask);
+    int DestroyEventGroup(neosmart_eventgroup_t group);
+#endif
+    neosmart_waitset_t CreateWaitSet(neosmart_event_t *events, int count);
+    int WaitForWaitSet(neosmart_waitset_t waitset, bool waitAll, uint64_t milliseconds);
+    int WaitForWaitSet(neosmart_waitset_t waitset, bool waitAll, uint64_t milliseconds,
+                       int &index);
+    int DestroyWaitSet(neosmart_waitset_t waitset);
+#ifndef _WIN32
+    // An IOCP-style completion port for multiplexing many events over a few dispatcher threads:
+    // associate each (auto-reset) event with the port once, and every subsequent signal against
+    // it is queued as a completion carrying the association's key instead of being stored in the
+    // event — dequeued in O(1) by GetQueuedEvent() with no per-wait registration. Associating
+    // with a null port dissolves the association. Destroy (or dissociate) all associated events
+    // before destroying the port.
+    neosmart_port_t CreatePort();
+    int AssociateEvent(neosmart_port_t port, neosmart_event_t event, uintptr_t key);
+    int GetQueuedEvent(neosmart_port_t port, uintptr_t &key,
+                       uint64_t milliseconds = WAIT_INFINITE);
+    int DestroyPort(neosmart_port_t port);
+#endif
 #endif
 #ifdef PULSE
     int PulseEvent(neosmart_event_t event);
 #endif
+#if defined(CORO) && !defined(_WIN32)
+    // One registered awaiter: a type-erased resumption callback linked into the event's awaiter
+    // list, turning a wait into a handle-sized registration instead of a parked thread. The node
+    // must stay alive until its callback fires (it lives in the coroutine frame when used via
+    // WaitForEventAsync() below). The library itself remains C++11: only the co_await sugar
+    // further down needs a C++20 compiler, and it is header-only.
+    struct neosmart_await_t_ {
+        void (*Resume)(void *context);
+        void *Context;
+        neosmart_await_t_ *Next;
+    };
+    // Returns 0 if the awaiter was registered (a future signal will invoke Resume, on the
+    // signaling thread, after all event locks are dropped), or 1 if the event was already
+    // signaled and the signal has been consumed per the event's reset/count semantics — in which
+    // case Resume will never be invoked and the caller should proceed inline.
+    int RegisterAwait(neosmart_event_t event, neosmart_await_t_ *await);
+
+#ifdef __cpp_impl_coroutine
+    struct neosmart_event_awaiter_t {
+        neosmart_event_t Event;
+        // Null: resume the coroutine directly on the signaling thread. Otherwise the handle is
+        // passed to the executor (with the opaque context), which schedules the resumption.
+        void (*Executor)(std::coroutine_handle<>, void *);
+        void *ExecutorContext;
+        std::coroutine_handle<> Handle;
+        neosmart_await_t_ Await;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) noexcept {
+            Handle = handle;
+            Await.Resume = [](void *context) {
+                neosmart_event_awaiter_t *self = static_cast<neosmart_event_awaiter_t *>(context);
+                if (self->Executor != nullptr) {
+                    self->Executor(self->Handle, self->ExecutorContext);
+                } else {
+                    self->Handle.resume();
+                }
+            };
+            Await.Context = this;
+            // false: the event was already signaled (and consumed); continue without suspending
+            return RegisterAwait(Event, &Await) == 0;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    // `co_await WaitForEventAsync(event)` suspends the coroutine until the event is signaled,
+    // consuming the signal exactly like WaitForEvent() would (auto-reset/counted semantics
+    // included) but without parking a thread. With no executor the coroutine resumes inline on
+    // the signaling thread — keep such continuations short and never block them on the same
+    // event family, or hand resumption off to your scheduler via `executor`.
+    inline neosmart_event_awaiter_t
+    WaitForEventAsync(neosmart_event_t event,
+                      void (*executor)(std::coroutine_handle<>, void *) = nullptr,
+                      void *executorContext = nullptr) {
+        return neosmart_event_awaiter_t{event, executor, executorContext, {}, {}};
+    }
+#endif // __cpp_impl_coroutine
+#endif // CORO && !_WIN32
+#ifdef STATS
+    // A point-in-time snapshot of an event's hot-path statistics counters. The counters are
+    // maintained with relaxed atomic increments and cost a few cycles each on paths that already
+    // touch the event's cache lines; when the library is built without stats support they (and
+    // this API) compile to nothing.
+    struct neosmart_event_stats_t {
+        uint64_t Waits;           // WaitForEvent() calls against this event
+        uint64_t LockWaits;       // event mutex acquisitions that had to block
+        uint64_t SpuriousWakeups; // wakeups that found the event unobtainable
+        uint64_t WaitersWoken;    // blocked waiters released (directly or via a registered WFMO
+                                  // wait)
+        uint64_t ExpiredWaits;    // expired WFMO registrations swept from this event's wait list
+    };
+    int GetEventStats(neosmart_event_t event, neosmart_event_stats_t &stats);
+#endif
 } // namespace neosmart
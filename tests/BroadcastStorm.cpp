@@ -0,0 +1,95 @@
+// Stress for the manual-reset broadcast path: a signal must release a large population of
+// registered multi-event waiters (exercising the detached, out-of-lock notification when all
+// registrations are transient, and the in-place walk when a wait-set keeps persistent nodes on
+// the event), with no waiter lost or stuck across repeated rounds.
+
+#include <atomic>
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+static void Storm(neosmart_event_t broadcast, neosmart_event_t decoy, bool holdWaitSet) {
+    const int waiters = 64;
+    const int rounds = 50;
+
+#ifdef _WIN32
+    (void)holdWaitSet;
+    neosmart_waitset_t waitset = nullptr;
+#else
+    // A standing wait-set keeps persistent registrations linked on the event, forcing the
+    // broadcast down the in-place walk instead of the detached fast path
+    neosmart_waitset_t waitset = nullptr;
+    if (holdWaitSet) {
+        neosmart_event_t group[2] = {broadcast, decoy};
+        waitset = CreateWaitSet(group, 2);
+    }
+#endif
+
+    std::atomic<int> released(0);
+    std::atomic<uint64_t> round(0);
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < waiters; ++i) {
+        threads.push_back(std::thread([&] {
+            neosmart_event_t events[2] = {decoy, broadcast};
+            // The round counter keeps one broadcast from being counted twice by the same thread
+            // while the event is still latched; waiting out the reset instead would deadlock a
+            // thread delayed past the reset into the next round's broadcast
+            uint64_t seen = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                int index = -1;
+                int result = WaitForMultipleEvents(events, 2, false, WAIT_INFINITE, index);
+                assert(result == 0 && index == 1);
+                (void)result;
+                uint64_t current = round.load(std::memory_order_relaxed);
+                if (current == seen) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                seen = current;
+                released.fetch_add(1, std::memory_order_relaxed);
+            }
+        }));
+    }
+
+    for (int r = 0; r < rounds; ++r) {
+        released.store(0, std::memory_order_relaxed);
+        round.fetch_add(1, std::memory_order_relaxed);
+        SetEvent(broadcast);
+        for (int spins = 0; released.load(std::memory_order_relaxed) < waiters; ++spins) {
+            assert(spins < 20000 && "Broadcast lost a waiter!");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ResetEvent(broadcast);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    SetEvent(broadcast);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ResetEvent(broadcast);
+
+#ifndef _WIN32
+    if (waitset != nullptr) {
+        DestroyWaitSet(waitset);
+    }
+#endif
+}
+
+int main() {
+    neosmart_event_t broadcast = CreateEvent(true, false);
+    neosmart_event_t decoy = CreateEvent(false, false);
+
+    Storm(broadcast, decoy, false);
+    Storm(broadcast, decoy, true);
+
+    DestroyEvent(decoy);
+    DestroyEvent(broadcast);
+
+    return 0;
+}
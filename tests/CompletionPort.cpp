@@ -0,0 +1,112 @@
+// Tests for the completion-port multiplexer: signals against associated events must surface as
+// queued completions carrying the right keys (exactly one per signal), signals that predate the
+// association must be converted at association time, and a pool of dispatcher threads must be
+// able to drain completions concurrently without losing or duplicating any.
+
+#ifndef _WIN32
+
+#include <atomic>
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+int main() {
+    const int count = 64;
+    neosmart_event_t events[count];
+    neosmart_port_t port = CreatePort();
+
+    // An empty port times out
+    uintptr_t key = 0;
+    int result = GetQueuedEvent(port, key, 0);
+    assert(result == WAIT_TIMEOUT && "Empty port did not time out!");
+
+    for (int i = 0; i < count; ++i) {
+        events[i] = CreateEvent(false, false);
+        result = AssociateEvent(port, events[i], (uintptr_t)i);
+        assert(result == 0 && "AssociateEvent() call failed!");
+    }
+
+    // Each signal produces exactly one completion with the association's key
+    std::vector<int> seen(count, 0);
+    for (int i = 0; i < count; i += 2) {
+        SetEvent(events[i]);
+    }
+    for (int i = 0; i < count / 2; ++i) {
+        result = GetQueuedEvent(port, key);
+        assert(result == 0 && "GetQueuedEvent() call failed!");
+        assert(key < (uintptr_t)count && key % 2 == 0 && "Unexpected completion key!");
+        ++seen[key];
+    }
+    result = GetQueuedEvent(port, key, 0);
+    assert(result == WAIT_TIMEOUT && "Surplus completion queued!");
+    for (int i = 0; i < count; i += 2) {
+        assert(seen[i] == 1 && "Completion lost or duplicated!");
+    }
+
+    // A signal that predates the association is converted into a completion when associating
+    neosmart_event_t preSignaled = CreateEvent(false, true);
+    result = AssociateEvent(port, preSignaled, (uintptr_t)count);
+    assert(result == 0);
+    result = GetQueuedEvent(port, key, 0);
+    assert(result == 0 && key == (uintptr_t)count && "Pre-association signal not queued!");
+    DestroyEvent(preSignaled);
+
+    // Manual-reset events cannot be associated
+    neosmart_event_t manual = CreateEvent(true, false);
+    result = AssociateEvent(port, manual, 0);
+    assert(result != 0 && "Manual-reset association unexpectedly succeeded!");
+    DestroyEvent(manual);
+
+    // Concurrent dispatchers drain a burst of signals without loss or duplication
+    const int dispatchers = 4;
+    const int rounds = 500;
+    std::atomic<int> dequeued(0);
+    std::vector<std::atomic<int>> counts(count);
+    for (int i = 0; i < count; ++i) {
+        counts[i].store(0);
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < dispatchers; ++i) {
+        threads.push_back(std::thread([&] {
+            uintptr_t dequeuedKey;
+            while (dequeued.fetch_add(1, std::memory_order_relaxed) < rounds * count) {
+                int waitResult = GetQueuedEvent(port, dequeuedKey);
+                assert(waitResult == 0 && "GetQueuedEvent() call failed!");
+                (void)waitResult;
+                counts[dequeuedKey].fetch_add(1, std::memory_order_relaxed);
+            }
+        }));
+    }
+
+    for (int round = 0; round < rounds; ++round) {
+        for (int i = 0; i < count; ++i) {
+            SetEvent(events[i]);
+        }
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (int i = 0; i < count; ++i) {
+        assert(counts[i].load() == rounds && "Completion lost or duplicated under contention!");
+    }
+
+    for (int i = 0; i < count; ++i) {
+        DestroyEvent(events[i]);
+    }
+    DestroyPort(port);
+
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif // !_WIN32
@@ -0,0 +1,128 @@
+// Tests for the coroutine awaiter layer: co_await against an already-signaled event must
+// complete inline, a pending awaiter must be resumed by the signaling thread (consuming the
+// signal per auto-reset/counted semantics), a manual-reset signal must release every awaiter,
+// and a caller-supplied executor must receive the handle instead of an inline resumption.
+
+#ifndef _WIN32
+
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+// Fire-and-forget coroutine: runs eagerly until its first suspension and cleans itself up
+struct task {
+    struct promise_type {
+        task get_return_object() {
+            return {};
+        }
+        std::suspend_never initial_suspend() {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+};
+
+static task Await(neosmart_event_t event, std::atomic<int> &resumed) {
+    co_await WaitForEventAsync(event);
+    resumed.fetch_add(1, std::memory_order_relaxed);
+}
+
+static task AwaitVia(neosmart_event_t event, void (*executor)(std::coroutine_handle<>, void *),
+                     void *context, std::atomic<int> &resumed) {
+    co_await WaitForEventAsync(event, executor, context);
+    resumed.fetch_add(1, std::memory_order_relaxed);
+}
+
+int main() {
+    // An already-signaled event completes inline, without suspending, consuming the signal
+    neosmart_event_t event = CreateEvent(false, true);
+    std::atomic<int> resumed(0);
+    Await(event, resumed);
+    assert(resumed.load() == 1 && "co_await on a signaled event did not complete inline!");
+    assert(WaitForEvent(event, 0) == WAIT_TIMEOUT && "co_await did not consume the signal!");
+
+    // A pending awaiter is resumed by SetEvent(); the signal goes to the awaiter, not the state
+    Await(event, resumed);
+    assert(resumed.load() == 1 && "co_await on an unsignaled event did not suspend!");
+    SetEvent(event);
+    assert(resumed.load() == 2 && "SetEvent() did not resume the awaiter!");
+    assert(WaitForEvent(event, 0) == WAIT_TIMEOUT && "Signal leaked past the awaiter!");
+
+    // Awaiters are resumed in registration order, one per signal
+    Await(event, resumed);
+    Await(event, resumed);
+    SetEvent(event);
+    assert(resumed.load() == 3 && "First of two awaiters not resumed!");
+    SetEvent(event);
+    assert(resumed.load() == 4 && "Second of two awaiters not resumed!");
+
+    // A signal from another thread resumes the coroutine on that thread
+    Await(event, resumed);
+    std::thread signaler([&] { SetEvent(event); });
+    signaler.join();
+    assert(resumed.load() == 5 && "Cross-thread signal did not resume the awaiter!");
+    DestroyEvent(event);
+
+    // A manual-reset signal releases every registered awaiter
+    neosmart_event_t manual = CreateEvent(true, false);
+    std::atomic<int> manualResumed(0);
+    for (int i = 0; i < 8; ++i) {
+        Await(manual, manualResumed);
+    }
+    assert(manualResumed.load() == 0);
+    SetEvent(manual);
+    assert(manualResumed.load() == 8 && "Manual-reset signal did not release all awaiters!");
+    // The event is now signaled; further awaits complete inline
+    Await(manual, manualResumed);
+    assert(manualResumed.load() == 9);
+    DestroyEvent(manual);
+
+    // ReleaseEvent(n) resumes up to n awaiters, one unit apiece
+    neosmart_event_t counted = CreateCountedEvent(0);
+    std::atomic<int> countedResumed(0);
+    for (int i = 0; i < 3; ++i) {
+        Await(counted, countedResumed);
+    }
+    ReleaseEvent(counted, 2);
+    assert(countedResumed.load() == 2 && "ReleaseEvent() did not resume two awaiters!");
+    ReleaseEvent(counted, 2);
+    assert(countedResumed.load() == 3 && "ReleaseEvent() did not resume the last awaiter!");
+    assert(WaitForEvent(counted, 0) == 0 && "Surplus unit not left in the count!");
+    DestroyEvent(counted);
+
+    // A caller-supplied executor takes delivery of the handle instead of an inline resumption
+    neosmart_event_t deferred = CreateEvent(false, false);
+    std::atomic<int> deferredResumed(0);
+    std::vector<std::coroutine_handle<>> queue;
+    auto executor = [](std::coroutine_handle<> handle, void *context) {
+        static_cast<std::vector<std::coroutine_handle<>> *>(context)->push_back(handle);
+    };
+    AwaitVia(deferred, executor, &queue, deferredResumed);
+    SetEvent(deferred);
+    assert(deferredResumed.load() == 0 && "Executor-bound awaiter resumed inline!");
+    assert(queue.size() == 1 && "Executor did not receive the handle!");
+    queue.front().resume();
+    assert(deferredResumed.load() == 1 && "Executor-driven resumption failed!");
+    DestroyEvent(deferred);
+
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif // !_WIN32
@@ -0,0 +1,76 @@
+// Tests for counted (semaphore-style) events: the initial count must be consumable one wait at a
+// time, ReleaseEvent(n) must release exactly n waits (blocked or future), and a single release
+// must wake a whole group of blocked waiters at once.
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <atomic>
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+int main() {
+    // The initial count is consumed one unit per wait
+    neosmart_event_t counted = CreateCountedEvent(3);
+    for (int i = 0; i < 3; ++i) {
+        int result = WaitForEvent(counted, 0);
+        assert(result == 0 && "Initial count not consumable!");
+    }
+    int result = WaitForEvent(counted, 0);
+    assert(result == WAIT_TIMEOUT && "Count over-consumed!");
+
+    // ReleaseEvent(n) adds exactly n units
+    result = ReleaseEvent(counted, 5);
+    assert(result == 0 && "ReleaseEvent() call failed!");
+    for (int i = 0; i < 5; ++i) {
+        result = WaitForEvent(counted, 0);
+        assert(result == 0 && "Released unit not consumable!");
+    }
+    result = WaitForEvent(counted, 0);
+    assert(result == WAIT_TIMEOUT && "Count over-consumed!");
+
+#ifndef _WIN32
+    // SetEvent() on a counted event releases a single unit (POSIX backends only; on Windows a
+    // counted event is a kernel semaphore and SetEvent() does not apply)
+    result = SetEvent(counted);
+    assert(result == 0);
+    result = WaitForEvent(counted, 0);
+    assert(result == 0 && "SetEvent() did not release a unit!");
+    result = WaitForEvent(counted, 0);
+    assert(result == WAIT_TIMEOUT);
+#endif
+
+    // One release wakes a whole group of blocked waiters
+    const int waiters = 16;
+    std::atomic<int> released(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < waiters; ++i) {
+        threads.push_back(std::thread([&] {
+            int waitResult = WaitForEvent(counted);
+            assert(waitResult == 0 && "WaitForEvent() call failed!");
+            (void)waitResult;
+            released.fetch_add(1, std::memory_order_relaxed);
+        }));
+    }
+
+    // Give the waiters a moment to block, then release them all with one call
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(released.load(std::memory_order_relaxed) == 0 && "Waiter released early!");
+    result = ReleaseEvent(counted, waiters);
+    assert(result == 0 && "ReleaseEvent() call failed!");
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    assert(released.load(std::memory_order_relaxed) == waiters);
+    result = WaitForEvent(counted, 0);
+    assert(result == WAIT_TIMEOUT && "Count left over after group release!");
+
+    DestroyEvent(counted);
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Tests for arena-allocated event arrays: the block must behave exactly like individually
+// created events (signal, wait, reset, WFMO), land each event on its own cache line, and keep
+// its lifetime intact through concurrent use.
+
+#include <cassert>
+#include <cstdint>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+int main() {
+    const int count = 256;
+    std::vector<neosmart_event_t> events(count);
+    int result = CreateEventArray(events.data(), count, false, false);
+    assert(result == 0 && "CreateEventArray() call failed!");
+
+#ifndef _WIN32
+    // Each event gets its own cache line(s): no two events within 64 bytes of each other
+    for (int i = 1; i < count; ++i) {
+        intptr_t spacing = reinterpret_cast<intptr_t>(events[i]) -
+                           reinterpret_cast<intptr_t>(events[i - 1]);
+        assert(spacing >= 64 && spacing % 64 == 0 && "Events not cache-line padded!");
+        (void)spacing;
+    }
+#endif
+
+    // Arena events behave like individually created ones
+    for (int i = 0; i < count; ++i) {
+        assert(WaitForEvent(events[i], 0) == WAIT_TIMEOUT);
+        SetEvent(events[i]);
+        assert(WaitForEvent(events[i], 0) == 0 && "Arena event signal lost!");
+        assert(WaitForEvent(events[i], 0) == WAIT_TIMEOUT && "Auto-reset not honored!");
+    }
+
+    // Concurrent producers/consumers across the block
+    const int threads = 4;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t] {
+            for (int i = t; i < count; i += threads) {
+                SetEvent(events[i]);
+            }
+        }));
+    }
+    for (int i = 0; i < count; ++i) {
+        result = WaitForEvent(events[i]);
+        assert(result == 0 && "Concurrent wait on arena event failed!");
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+#ifdef WFMO
+    int index = -1;
+    SetEvent(events[137]);
+    result = WaitForMultipleEvents(events.data() + 130, 10, false, WAIT_INFINITE, index);
+    assert(result == 0 && index == 7 && "WFMO against arena events failed!");
+#endif
+
+    result = DestroyEventArray(events.data(), count);
+    assert(result == 0 && "DestroyEventArray() call failed!");
+
+    // Manual-reset blocks with initial state
+    result = CreateEventArray(events.data(), 16, true, true);
+    assert(result == 0);
+    for (int i = 0; i < 16; ++i) {
+        assert(WaitForEvent(events[i], 0) == 0 && "Initial state not applied!");
+        assert(WaitForEvent(events[i], 0) == 0 && "Manual reset not honored!");
+        ResetEvent(events[i]);
+        assert(WaitForEvent(events[i], 0) == WAIT_TIMEOUT);
+    }
+    result = DestroyEventArray(events.data(), 16);
+    assert(result == 0);
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Tests for the GetEventFd() bridge: the fd must poll readable exactly while the event is
+// signaled, across SetEvent()/ResetEvent() transitions and auto-reset consumption, and must make
+// a blocked poll() return when the event is signaled from another thread. Windows events are
+// natively waitable, so there is nothing to test there.
+
+#ifndef _WIN32
+
+#include <cassert>
+#include <pevents.h>
+#include <poll.h>
+#include <thread>
+
+using namespace neosmart;
+
+static bool FdReadable(int fd, int timeoutMilliseconds = 0) {
+    pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return poll(&pfd, 1, timeoutMilliseconds) == 1 && (pfd.revents & POLLIN) != 0;
+}
+
+int main() {
+    // Manual-reset: the fd tracks SetEvent()/ResetEvent()
+    neosmart_event_t manual = CreateEvent(true, false);
+    int fd = GetEventFd(manual);
+    assert(fd != -1 && "GetEventFd() call failed!");
+    assert(GetEventFd(manual) == fd && "GetEventFd() not idempotent!");
+    assert(!FdReadable(fd) && "Bridge fd readable while event unsignaled!");
+
+    SetEvent(manual);
+    assert(FdReadable(fd) && "Bridge fd not readable after SetEvent()!");
+    // Repeated signals coalesce; the fd stays readable
+    SetEvent(manual);
+    assert(FdReadable(fd));
+
+    ResetEvent(manual);
+    assert(!FdReadable(fd) && "Bridge fd readable after ResetEvent()!");
+
+    // An event signaled before the bridge is attached must be picked up at attach time
+    neosmart_event_t preSignaled = CreateEvent(true, true);
+    int preFd = GetEventFd(preSignaled);
+    assert(preFd != -1);
+    assert(FdReadable(preFd) && "Pre-signaled state not reflected by a new bridge fd!");
+    DestroyEvent(preSignaled);
+
+    // Auto-reset: consuming the event clears the fd
+    neosmart_event_t autoReset = CreateEvent(false, false);
+    int autoFd = GetEventFd(autoReset);
+    assert(autoFd != -1);
+
+    SetEvent(autoReset);
+    assert(FdReadable(autoFd) && "Bridge fd not readable after SetEvent()!");
+    int result = WaitForEvent(autoReset, 0);
+    assert(result == 0);
+    assert(!FdReadable(autoFd) && "Bridge fd readable after auto-reset consumption!");
+
+    // A blocked poll() must be released by a signal from another thread
+    std::thread signaler([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        SetEvent(autoReset);
+    });
+    assert(FdReadable(autoFd, 10000) && "poll() not released by SetEvent()!");
+    signaler.join();
+    result = WaitForEvent(autoReset, 0);
+    assert(result == 0);
+
+    DestroyEvent(manual);
+    DestroyEvent(autoReset);
+
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif // !_WIN32
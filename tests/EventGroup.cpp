@@ -0,0 +1,111 @@
+// Tests for packed-readiness event groups (CreateEventGroup/WaitForEventGroup): the bitmap
+// scan must find and consume signals exactly like the per-event WFMO scan would — lowest index
+// first, honoring reset semantics — while staying coherent as members are signaled, consumed,
+// and reset both through group waits and as ordinary standalone events.
+
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+#ifdef _WIN32
+// Event groups are POSIX-only; Windows events are kernel objects
+int main() {
+    return 0;
+}
+#else
+
+int main() {
+    const int count = 100;
+    std::vector<neosmart_event_t> events(count);
+    neosmart_eventgroup_t group = CreateEventGroup(events.data(), count, false, false);
+    assert(group != nullptr);
+
+    // An unsignaled group times out, with and without blocking
+    int index = -1;
+    assert(WaitForEventGroup(group, false, 0, index) == WAIT_TIMEOUT);
+    assert(WaitForEventGroup(group, false, 50, index) == WAIT_TIMEOUT);
+
+    // The packed scan finds a signal deep in the group and consumes it
+    SetEvent(events[67]);
+    assert(WaitForEventGroup(group, false, 0, index) == 0 && index == 67 &&
+           "Packed scan missed a signaled member!");
+    assert(WaitForEvent(events[67], 0) == WAIT_TIMEOUT && "Group wait did not consume!");
+
+    // The lowest signaled index wins, as with the per-event scan
+    SetEvent(events[80]);
+    SetEvent(events[30]);
+    assert(WaitForEventGroup(group, false, 0, index) == 0 && index == 30);
+    assert(WaitForEventGroup(group, false, 0, index) == 0 && index == 80);
+
+    // Members remain ordinary events: a standalone consume must not leave a stale ready bit
+    SetEvent(events[12]);
+    assert(WaitForEvent(events[12]) == 0);
+    assert(WaitForEventGroup(group, false, 0, index) == WAIT_TIMEOUT &&
+           "Stale ready bit after a standalone consume!");
+    SetEvent(events[12]);
+    ResetEvent(events[12]);
+    assert(WaitForEventGroup(group, false, 0, index) == WAIT_TIMEOUT &&
+           "Stale ready bit after ResetEvent()!");
+
+    // A signal arriving while blocked wakes the group wait
+    std::thread signaler([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        SetEvent(events[91]);
+    });
+    assert(WaitForEventGroup(group, false, 5000, index) == 0 && index == 91);
+    signaler.join();
+
+    // Wait-all: a partially-signaled group polls out without consuming anything
+    for (int i = 0; i < 60; ++i) {
+        SetEvent(events[i]);
+    }
+    assert(WaitForEventGroup(group, true, 0, index) == WAIT_TIMEOUT);
+    assert(WaitForEventGroup(group, true, 100, index) == WAIT_TIMEOUT);
+    for (int i = 0; i < 60; ++i) {
+        assert(WaitForEvent(events[i], 0) == 0 && "Timed-out group wait-all ate a signal!");
+    }
+
+    // ... and succeeds once every member is set, consuming them all
+    for (int i = 0; i < count; ++i) {
+        SetEvent(events[i]);
+    }
+    assert(WaitForEventGroup(group, true, 5000, index) == 0);
+    assert(WaitForEventGroup(group, false, 0, index) == WAIT_TIMEOUT &&
+           "Group wait-all left a signal behind!");
+
+    DestroyEventGroup(group);
+
+    // The mask form sweeps every signaled member of a small group in one call
+    std::vector<neosmart_event_t> small(10);
+    group = CreateEventGroup(small.data(), 10, false, false);
+    SetEvent(small[2]);
+    SetEvent(small[5]);
+    SetEvent(small[7]);
+    uint64_t mask = 0;
+    assert(WaitForEventGroup(group, false, 0, mask) == 0);
+    assert(mask == ((1u << 2) | (1u << 5) | (1u << 7)) && "Mask sweep mismatch!");
+    assert(WaitForEventGroup(group, false, 0, mask) == WAIT_TIMEOUT && "Sweep did not consume!");
+    DestroyEventGroup(group);
+
+    // A manual-reset group member stays claimable until reset
+    group = CreateEventGroup(small.data(), 10, true, false);
+    SetEvent(small[3]);
+    assert(WaitForEventGroup(group, false, 0, index) == 0 && index == 3);
+    assert(WaitForEventGroup(group, false, 0, index) == 0 && index == 3);
+    ResetEvent(small[3]);
+    assert(WaitForEventGroup(group, false, 0, index) == WAIT_TIMEOUT);
+    DestroyEventGroup(group);
+
+    // Members created signaled start with their bits set
+    group = CreateEventGroup(small.data(), 10, false, true);
+    for (int i = 0; i < 10; ++i) {
+        assert(WaitForEventGroup(group, false, 0, index) == 0 && index == i);
+    }
+    DestroyEventGroup(group);
+
+    return 0;
+}
+#endif // _WIN32
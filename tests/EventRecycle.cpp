@@ -0,0 +1,91 @@
+// Tests for the event recycling cache (CreateEventCached/RecycleEvent): recycled events must
+// come back scrubbed — no stale signaled state, no leftover registrations — while reconfiguring
+// reset semantics per creation, across per-thread caches and the global overflow list.
+
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+#ifdef _WIN32
+// The recycling cache is POSIX-only; Windows events are kernel objects
+int main() {
+    return 0;
+}
+#else
+
+int main() {
+    // Cached creation honors the requested configuration
+    neosmart_event_t event = CreateEventCached(false, true);
+    assert(WaitForEvent(event, 0) == 0 && "Cached event not created signaled!");
+    assert(WaitForEvent(event, 0) == WAIT_TIMEOUT && "Cached event not auto-reset!");
+
+    // A recycled event's signaled state must not leak into its next incarnation
+    SetEvent(event);
+    RecycleEvent(event);
+    event = CreateEventCached(false, false);
+    assert(WaitForEvent(event, 0) == WAIT_TIMEOUT && "Recycled event came back signaled!");
+
+    // Reset semantics are per-creation, not sticky across recycling
+    RecycleEvent(event);
+    event = CreateEventCached(true, true);
+    assert(WaitForEvent(event, 0) == 0 && WaitForEvent(event, 0) == 0 &&
+           "Recycled event did not become manual-reset!");
+    RecycleEvent(event);
+
+#ifdef WFMO
+    // A timed-out multi-event wait leaves expired registrations behind; recycling must sweep
+    // them exactly as DestroyEvent() would
+    neosmart_event_t pair[2] = {CreateEventCached(false, false), CreateEventCached(false, false)};
+    assert(WaitForMultipleEvents(pair, 2, false, 50) == WAIT_TIMEOUT);
+    RecycleEvent(pair[0]);
+    RecycleEvent(pair[1]);
+#endif
+
+    // Heavy single-thread churn, mixing configurations, with real signal/wait traffic
+    for (int i = 0; i < 1000; ++i) {
+        neosmart_event_t churn = CreateEventCached(i % 3 == 0, false);
+        SetEvent(churn);
+        assert(WaitForEvent(churn, 0) == 0 && "Churned event lost a signal!");
+        RecycleEvent(churn);
+    }
+
+    // Concurrent churn across threads exercises the global overflow hand-off
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([] {
+            for (int i = 0; i < 500; ++i) {
+                neosmart_event_t churn = CreateEventCached(false, false);
+                SetEvent(churn);
+                assert(WaitForEvent(churn, 0) == 0 && "Churned event lost a signal!");
+                RecycleEvent(churn);
+            }
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // Recycling far more events than the caches can park (the excess is destroyed outright),
+    // then drawing them all back out
+    std::vector<neosmart_event_t> bulk(400);
+    for (auto &entry : bulk) {
+        entry = CreateEventCached(false, false);
+    }
+    for (auto &entry : bulk) {
+        RecycleEvent(entry);
+    }
+    for (auto &entry : bulk) {
+        entry = CreateEventCached(false, true);
+        assert(WaitForEvent(entry, 0) == 0 && "Bulk-recycled event not scrubbed/re-armed!");
+    }
+    // A cached event is an ordinary event; plain DestroyEvent() works too
+    for (auto &entry : bulk) {
+        DestroyEvent(entry);
+    }
+
+    return 0;
+}
+#endif // _WIN32
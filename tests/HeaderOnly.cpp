@@ -0,0 +1,41 @@
+// Verifies the PEVENTS_HEADER_ONLY single-header build: the entire implementation is emitted
+// inline into this translation unit from the generated pevents.hpp (no library linked), and the
+// basic signal/wait paths still behave.
+
+#define PEVENTS_HEADER_ONLY
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <cassert>
+#include <pevents.hpp>
+#include <thread>
+
+using namespace neosmart;
+
+int main() {
+    neosmart_event_t event = CreateEvent(false, false);
+
+    int result = WaitForEvent(event, 0);
+    assert(result == WAIT_TIMEOUT && "Unsignaled event did not time out!");
+
+    SetEvent(event);
+    result = WaitForEvent(event, 0);
+    assert(result == 0 && "Signaled event not obtained!");
+
+    std::thread signaler([&] { SetEvent(event); });
+    result = WaitForEvent(event);
+    assert(result == 0 && "WaitForEvent() call failed!");
+    signaler.join();
+
+#ifdef WFMO
+    neosmart_event_t events[2] = {event, CreateEvent(true, true)};
+    int index = -1;
+    result = WaitForMultipleEvents(events, 2, false, 0, index);
+    assert(result == 0 && index == 1 && "WFMO wait failed in header-only build!");
+    DestroyEvent(events[1]);
+#endif
+
+    DestroyEvent(event);
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Tests for priority-aware wakeup ordering: an auto-reset signal must be handed to the
+// highest-priority registered waiter regardless of arrival order, with FIFO preserved among
+// equal priorities so non-opted-in waits keep their existing behavior.
+
+#include <atomic>
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+#ifdef _WIN32
+// Prioritized waits are POSIX-only; Windows events are kernel objects with kernel wake order
+int main() {
+    return 0;
+}
+#else
+
+// Start one waiter per entry of `priorities` — staggered, so arrival (registration) order is
+// the array order — then signal `event` once per waiter and check that the waiters were served
+// in `expected` order (expressed as arrival indices, so FIFO among equal priorities is
+// genuinely verified, not just the rank grouping).
+static void CheckOrder(neosmart_event_t event, const std::vector<int> &priorities,
+                       const std::vector<int> &expected, bool useWfmo, neosmart_event_t decoy) {
+    std::vector<int> log;
+    std::atomic<int> served(0);
+    pthread_mutex_t logLock = PTHREAD_MUTEX_INITIALIZER;
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < priorities.size(); ++i) {
+        int priority = priorities[i];
+        threads.push_back(std::thread([&, i, priority] {
+            int result;
+            if (useWfmo) {
+                neosmart_event_t pair[2] = {decoy, event};
+                int index = -1;
+                result = WaitForMultipleEvents(pair, 2, false, WAIT_INFINITE, index, priority);
+                assert(result == 0 && index == 1);
+            } else {
+                result = WaitForEvent(event, WAIT_INFINITE, priority);
+                assert(result == 0);
+            }
+            (void)result;
+
+            pthread_mutex_lock(&logLock);
+            log.push_back((int)i);
+            pthread_mutex_unlock(&logLock);
+            served.fetch_add(1, std::memory_order_relaxed);
+        }));
+        // Give the waiter time to register and block before starting the next, so arrival
+        // order deterministically matches the array order
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    }
+
+    for (size_t i = 0; i < priorities.size(); ++i) {
+        SetEvent(event);
+        while (served.load(std::memory_order_relaxed) != (int)(i + 1)) {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    assert(log == expected && "Waiters not served in priority order!");
+    (void)expected;
+}
+
+int main() {
+    neosmart_event_t event = CreateEvent(false, false);
+    neosmart_event_t decoy = CreateEvent(false, false);
+
+    // Priorities win over arrival order, for both single-event and multi-event prioritized waits
+    CheckOrder(event, {1, 5, 3}, {1, 2, 0}, false, decoy);
+    CheckOrder(event, {1, 5, 3}, {1, 2, 0}, true, decoy);
+
+    // Negative priorities rank below the default
+    CheckOrder(event, {-2, 0, -1}, {1, 2, 0}, false, decoy);
+
+    // Equal priorities keep FIFO arrival order
+    CheckOrder(event, {7, 7, 7}, {0, 1, 2}, false, decoy);
+
+    // Mixed ranks: descending priority, FIFO within each rank
+    CheckOrder(event, {2, 9, 2, 9}, {1, 3, 0, 2}, true, decoy);
+
+    // A prioritized wait against an already-signaled event completes immediately
+    SetEvent(event);
+    assert(WaitForEvent(event, 0, 5) == 0 && "Signaled prioritized wait failed!");
+    assert(WaitForEvent(event, 0, 5) == WAIT_TIMEOUT && "Prioritized wait didn't consume!");
+
+    DestroyEvent(decoy);
+    DestroyEvent(event);
+
+    return 0;
+}
+#endif // _WIN32
@@ -0,0 +1,106 @@
+// Tests for the fused PulseEvent(): a pulse must release only threads that were already waiting
+// when it fired — all of them for a manual-reset event, exactly one for an auto-reset event —
+// and must never leave the event signaled for a waiter that arrives afterwards.
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+// Give `condition` a generous window to become true without hard-coding a single sleep
+template <typename Predicate>
+static bool EventuallyTrue(Predicate condition) {
+    for (int i = 0; i < 2000; ++i) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return condition();
+}
+
+int main() {
+    // A pulse with no waiters is not stored: a subsequent wait observes nothing
+    neosmart_event_t event = CreateEvent(false, false);
+    PulseEvent(event);
+    int result = WaitForEvent(event, 0);
+    assert(result == WAIT_TIMEOUT && "Pulse with no waiters was stored in the event!");
+
+    // An auto-reset pulse releases exactly one of the blocked waiters per pulse
+    const int waiters = 4;
+    std::atomic<int> released(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < waiters; ++i) {
+        threads.push_back(std::thread([&] {
+            int waitResult = WaitForEvent(event);
+            assert(waitResult == 0);
+            (void)waitResult;
+            released.fetch_add(1, std::memory_order_relaxed);
+        }));
+    }
+    // No release count to observe before the threads block; a grace period is the best we can do
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    for (int i = 0; i < waiters; ++i) {
+        PulseEvent(event);
+        bool ok = EventuallyTrue([&] { return released.load(std::memory_order_relaxed) == i + 1; });
+        assert(ok && "Auto-reset pulse did not release exactly one waiter!");
+        (void)ok;
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    result = WaitForEvent(event, 0);
+    assert(result == WAIT_TIMEOUT && "Auto-reset pulse leaked into the event state!");
+    DestroyEvent(event);
+
+    // A manual-reset pulse releases every blocked waiter at once, and only those
+    neosmart_event_t manual = CreateEvent(true, false);
+    released.store(0);
+    threads.clear();
+    for (int i = 0; i < waiters; ++i) {
+        threads.push_back(std::thread([&] {
+            int waitResult = WaitForEvent(manual);
+            assert(waitResult == 0);
+            (void)waitResult;
+            released.fetch_add(1, std::memory_order_relaxed);
+        }));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    PulseEvent(manual);
+    bool ok = EventuallyTrue([&] { return released.load(std::memory_order_relaxed) == waiters; });
+    assert(ok && "Manual-reset pulse did not release all blocked waiters!");
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    result = WaitForEvent(manual, 0);
+    assert(result == WAIT_TIMEOUT && "Manual-reset pulse left the event signaled!");
+    DestroyEvent(manual);
+
+#ifdef WFMO
+    // A pulse is delivered to registered multi-event waits the same way a signal would be
+    neosmart_event_t events[2] = {CreateEvent(false, false), CreateEvent(false, false)};
+    released.store(0);
+    std::thread wfmoWaiter([&] {
+        int index = -1;
+        int waitResult = WaitForMultipleEvents(events, 2, false, WAIT_INFINITE, index);
+        assert(waitResult == 0 && index == 1);
+        (void)waitResult;
+        released.fetch_add(1, std::memory_order_relaxed);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    PulseEvent(events[1]);
+    ok = EventuallyTrue([&] { return released.load(std::memory_order_relaxed) == 1; });
+    assert(ok && "Pulse was not delivered to a registered multi-event wait!");
+    wfmoWaiter.join();
+    assert(WaitForEvent(events[1], 0) == WAIT_TIMEOUT);
+    DestroyEvent(events[0]);
+    DestroyEvent(events[1]);
+#endif
+    (void)ok;
+
+    return 0;
+}
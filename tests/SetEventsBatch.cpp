@@ -0,0 +1,61 @@
+// Tests for the batched SetEvents() call: a WFMO waiter registered with every event in the batch
+// must be woken exactly once (with all events observed for a waitAll wait), and signaling a batch
+// with no waiters must leave each event in its signaled state.
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+
+using namespace neosmart;
+
+int main() {
+    const int count = 8;
+    neosmart_event_t events[count];
+
+    // No waiters: SetEvents() should leave every event signaled
+    for (int i = 0; i < count; ++i) {
+        events[i] = CreateEvent(i % 2 == 0, false);
+    }
+    int result = SetEvents(events, count);
+    assert(result == 0 && "SetEvents() call failed!");
+    for (int i = 0; i < count; ++i) {
+        result = WaitForEvent(events[i], 0);
+        assert(result == 0 && "Event not signaled after SetEvents()!");
+        DestroyEvent(events[i]);
+    }
+
+    // A waitAll WFMO waiter registered with every event in the batch should be released by a
+    // single SetEvents() call
+    for (int i = 0; i < count; ++i) {
+        events[i] = CreateEvent(false, false);
+    }
+
+    neosmart_event_t ready = CreateEvent(false, false);
+    std::thread waiter([&] {
+        SetEvent(ready);
+        int waitResult = WaitForMultipleEvents(events, count, true, WAIT_INFINITE);
+        assert(waitResult == 0 && "WFMO waiter not released by SetEvents()!");
+        (void)waitResult;
+    });
+
+    // Wait until the waiter thread is up (and give it a moment to register its waits) before
+    // signaling the whole batch at once
+    result = WaitForEvent(ready);
+    assert(result == 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    result = SetEvents(events, count);
+    assert(result == 0 && "SetEvents() call failed!");
+
+    waiter.join();
+
+    for (int i = 0; i < count; ++i) {
+        DestroyEvent(events[i]);
+    }
+    DestroyEvent(ready);
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Tests for cross-process shared-memory events: an event constructed in an mmap'd region by one
+// process must be openable and waitable from a forked child, signals must cross the process
+// boundary in both directions, and OpenEventShared() must reject a region that doesn't hold a
+// live event.
+
+#ifndef _WIN32
+
+#include <cassert>
+#include <cstring>
+#include <pevents.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace neosmart;
+
+int main() {
+    // Two events: parent->child and child->parent, for an auto-reset ping-pong
+    size_t size = EventSharedSize();
+    void *region = mmap(nullptr, size * 2, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+                        -1, 0);
+    assert(region != MAP_FAILED);
+    void *pingRegion = region;
+    void *pongRegion = static_cast<char *>(region) + size;
+
+    neosmart_event_shared_t ping = CreateEventShared(pingRegion, false, false);
+    assert(ping != nullptr && "CreateEventShared() call failed!");
+    neosmart_event_shared_t pong = CreateEventShared(pongRegion, false, false);
+    assert(pong != nullptr);
+
+    // Basic single-process semantics first
+    int result = WaitForEventShared(ping, 0);
+    assert(result == WAIT_TIMEOUT && "Unsignaled shared event did not time out!");
+    SetEventShared(ping);
+    result = WaitForEventShared(ping, 0);
+    assert(result == 0 && "Signaled shared event not obtained!");
+    result = WaitForEventShared(ping, 0);
+    assert(result == WAIT_TIMEOUT && "Auto-reset shared event not consumed!");
+
+    // A region that doesn't hold a live event must be rejected
+    char garbage[256];
+    memset(garbage, 0, sizeof(garbage));
+    assert(OpenEventShared(garbage) == nullptr && "Garbage region unexpectedly opened!");
+
+    const int rounds = 100;
+    pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        // Child: attach to the parent-constructed events, then ping-pong
+        neosmart_event_shared_t childPing = OpenEventShared(pingRegion);
+        neosmart_event_shared_t childPong = OpenEventShared(pongRegion);
+        if (childPing == nullptr || childPong == nullptr) {
+            _exit(1);
+        }
+        for (int i = 0; i < rounds; ++i) {
+            if (WaitForEventShared(childPing) != 0) {
+                _exit(2);
+            }
+            SetEventShared(childPong);
+        }
+        _exit(0);
+    }
+
+    for (int i = 0; i < rounds; ++i) {
+        SetEventShared(ping);
+        result = WaitForEventShared(pong);
+        assert(result == 0 && "Cross-process wait failed!");
+    }
+
+    int status = -1;
+    pid_t waited = waitpid(child, &status, 0);
+    assert(waited == child);
+    (void)waited;
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0 && "Child process failed!");
+
+    // Manual-reset shared events stay signaled across processes until reset
+    DestroyEventShared(ping);
+    neosmart_event_shared_t manual = CreateEventShared(pingRegion, true, true);
+    child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        neosmart_event_shared_t childManual = OpenEventShared(pingRegion);
+        if (childManual == nullptr || WaitForEventShared(childManual, 0) != 0 ||
+            WaitForEventShared(childManual, 0) != 0) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+    waited = waitpid(child, &status, 0);
+    assert(waited == child);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0 && "Manual-reset child failed!");
+    ResetEventShared(manual);
+    result = WaitForEventShared(manual, 0);
+    assert(result == WAIT_TIMEOUT && "Reset shared event still signaled!");
+
+    DestroyEventShared(manual);
+    assert(OpenEventShared(pingRegion) == nullptr && "Destroyed shared event still opens!");
+    DestroyEventShared(pong);
+    munmap(region, size * 2);
+
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif // !_WIN32
@@ -0,0 +1,51 @@
+// Exercises events created with the spin-before-block wait flag: ping-pong handoffs between two
+// threads (the case the spin window is designed to absorb) must never lose a signal, regardless
+// of whether a given wait is resolved by the spinner or by the blocking fallback path.
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+
+using namespace neosmart;
+
+int main() {
+    neosmart_event_t ping = CreateEvent(false, false, true);
+    neosmart_event_t pong = CreateEvent(false, false, true);
+
+    const int rounds = 100000;
+    std::thread partner([&] {
+        for (int i = 0; i < rounds; ++i) {
+            int result = WaitForEvent(ping);
+            assert(result == 0 && "WaitForEvent() call failed!");
+            (void)result;
+            SetEvent(pong);
+        }
+    });
+
+    for (int i = 0; i < rounds; ++i) {
+        SetEvent(ping);
+        int result = WaitForEvent(pong);
+        assert(result == 0 && "WaitForEvent() call failed!");
+        (void)result;
+    }
+
+    partner.join();
+
+    // A manual-reset spin event must remain signaled for all comers
+    neosmart_event_t manual = CreateEvent(true, false, true);
+    SetEvent(manual);
+    for (int i = 0; i < 100; ++i) {
+        int result = WaitForEvent(manual, 0);
+        assert(result == 0 && "Manual-reset spin event not signaled!");
+        (void)result;
+    }
+
+    DestroyEvent(ping);
+    DestroyEvent(pong);
+    DestroyEvent(manual);
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Tests for the STATS-gated instrumentation counters: GetEventStats() snapshots must start at
+// zero and the Waits / WaitersWoken / ExpiredWaits counters must move when the corresponding
+// paths are exercised. The Windows backend reports all-zero snapshots, so the assertions about
+// counter movement only apply to the POSIX backends.
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+
+using namespace neosmart;
+
+int main() {
+    neosmart_event_t event = CreateEvent(false, false);
+
+    neosmart_event_stats_t stats;
+    int result = GetEventStats(event, stats);
+    assert(result == 0 && "GetEventStats() call failed!");
+    assert(stats.Waits == 0 && stats.LockWaits == 0 && stats.SpuriousWakeups == 0 &&
+           stats.WaitersWoken == 0 && stats.ExpiredWaits == 0);
+
+#ifndef _WIN32
+    // Every WaitForEvent() call is counted, including zero-timeout polls
+    for (int i = 0; i < 10; ++i) {
+        result = WaitForEvent(event, 0);
+        assert(result == WAIT_TIMEOUT);
+    }
+    result = GetEventStats(event, stats);
+    assert(result == 0);
+    assert(stats.Waits == 10 && "WaitForEvent() calls not counted!");
+
+    // A blocked waiter released by SetEvent() should register as a woken waiter
+    std::thread waiter([&] {
+        int waitResult = WaitForEvent(event);
+        assert(waitResult == 0 && "WaitForEvent() call failed!");
+        (void)waitResult;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    SetEvent(event);
+    waiter.join();
+
+    result = GetEventStats(event, stats);
+    assert(result == 0);
+    assert(stats.Waits == 11);
+    assert(stats.WaitersWoken >= 1 && "Blocked waiter wakeup not counted!");
+
+#ifdef WFMO
+    // A timed-out WFMO wait leaves an expired registration behind; the next signal (or wait)
+    // sweeps it and the sweep is counted
+    result = WaitForMultipleEvents(&event, 1, true, 10);
+    assert(result == WAIT_TIMEOUT && "WFMO wait unexpectedly succeeded!");
+
+    SetEvent(event);
+    result = WaitForEvent(event, 0);
+    assert(result == 0);
+
+    result = GetEventStats(event, stats);
+    assert(result == 0);
+    assert(stats.ExpiredWaits >= 1 && "Expired WFMO registration sweep not counted!");
+#endif
+#endif // !_WIN32
+
+    DestroyEvent(event);
+
+    return 0;
+}
@@ -1,8 +1,24 @@
-#ifdef _WIN32
-#include <Windows.h>
-#endif
+// Timed stress/regression harness. Unlike the functional tests, this runs mixed workloads
+// (auto-reset signal/wait pairs, manual-reset broadcasts, and WFMO groups) for a configurable
+// duration across a configurable thread count, then emits machine-readable throughput and
+// wake-latency percentiles, one `STRESS workload=... key=value ...` line per workload. It exits
+// non-zero on a correctness failure, or when a configured regression threshold is violated.
+//
+// Configuration is via the environment so the meson test invocation stays argument-free:
+//   PEVENTS_STRESS_THREADS      worker thread count per workload       (default: 8)
+//   PEVENTS_STRESS_MS           per-workload duration in milliseconds  (default: 1000)
+//   PEVENTS_STRESS_MIN_OPS     minimum per-workload ops/sec            (default: 0 = off)
+//   PEVENTS_STRESS_MAX_P99_US  maximum per-workload p99 wake latency   (default: 0 = off)
+// Build with -Db_sanitize=thread for the ThreadSanitizer flavor, and run it with
+// TSAN_OPTIONS=detect_deadlocks=0: TSan flags the WFMO registration (wfmo → event) vs. signal
+// (event → waiter) lock orders as a potential inversion, but the pair cannot actually cycle —
+// an event's wait list can never contain a waiter that is still registering with that event.
+
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <pevents.h>
 #include <thread>
@@ -10,103 +26,267 @@
 
 using namespace neosmart;
 
-const int THREADS = 64;
+static uint64_t EnvOr(const char *name, uint64_t fallback) {
+    const char *value = getenv(name);
+    return value != nullptr ? strtoull(value, nullptr, 10) : fallback;
+}
 
-int shared_resource = -1;
-neosmart_event_t workers[THREADS];
-neosmart_event_t shutdown;
-neosmart_event_t done[THREADS];
-int done_count = 0;
+static uint64_t NowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
 
-void worker(size_t index) {
-    neosmart_event_t events[] = { workers[index], shutdown };
+struct StressResult {
+    uint64_t Operations = 0;
+    // Nanoseconds from just before SetEvent() to just after the waiter's WaitForEvent() returns
+    std::vector<uint64_t> WakeLatencies;
+};
 
-    for (int i = 0; i < 5; ++i) {
-        int event_idx = -1;
-        int result = WaitForMultipleEvents(events, 2, false, 45000, event_idx);
-        if (result == WAIT_TIMEOUT) {
-            std::cerr << "[" << index << "] Error waiting for signalling event" << std::endl;
-            SetEvent(shutdown);
-            break;
-        }
-        else if (event_idx == 1) {
-            // Another thread errored out
-            break;
-        }
-        else if (shared_resource != -1) {
-            std::cerr << "[" << index << "] Shared resource accessed by more than one thread!" << std::endl;
-            SetEvent(shutdown);
-            break;
-        }
+static uint64_t Percentile(std::vector<uint64_t> &sorted, int percentile) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = (sorted.size() - 1) * percentile / 100;
+    return sorted[index];
+}
 
-        shared_resource = index;
-        // std::this_thread::sleep_for(std::chrono::milliseconds{rand() % 42});
-        std::this_thread::sleep_for(std::chrono::milliseconds(20));
-        ++done_count;
-        shared_resource = -1;
+// Reports one workload's numbers and returns false if a configured threshold was violated
+static bool Report(const char *workload, StressResult &result, uint64_t durationMs) {
+    std::sort(result.WakeLatencies.begin(), result.WakeLatencies.end());
+    uint64_t opsPerSec = durationMs != 0 ? result.Operations * 1000 / durationMs : 0;
+    uint64_t p50 = Percentile(result.WakeLatencies, 50) / 1000;
+    uint64_t p95 = Percentile(result.WakeLatencies, 95) / 1000;
+    uint64_t p99 = Percentile(result.WakeLatencies, 99) / 1000;
 
-        if (i == 4) {
-            SetEvent(done[index]);
-        }
+    std::cout << "STRESS workload=" << workload << " ops=" << result.Operations
+              << " ops_per_sec=" << opsPerSec << " p50_us=" << p50 << " p95_us=" << p95
+              << " p99_us=" << p99 << std::endl;
 
-        if (WaitForMultipleEvents(done, THREADS, true, 0) == 0) {
-            // All threads completed
-            break;
-        }
+    uint64_t minOps = EnvOr("PEVENTS_STRESS_MIN_OPS", 0);
+    uint64_t maxP99 = EnvOr("PEVENTS_STRESS_MAX_P99_US", 0);
+    if (minOps != 0 && opsPerSec < minOps) {
+        std::cerr << "STRESS FAIL workload=" << workload << " ops_per_sec=" << opsPerSec
+                  << " threshold=" << minOps << std::endl;
+        return false;
+    }
+    if (maxP99 != 0 && p99 > maxP99 && !result.WakeLatencies.empty()) {
+        std::cerr << "STRESS FAIL workload=" << workload << " p99_us=" << p99
+                  << " threshold=" << maxP99 << std::endl;
+        return false;
+    }
+    return true;
+}
 
-        // Wake next thread
-        size_t next_thread;
-        do {
-            next_thread = rand() % THREADS;
-        } while (WaitForEvent(done[next_thread], 0) != WAIT_TIMEOUT);
-        // std::cout << "[" << index << "] Waking worker " << next_thread << " (done_count: " << done_count << ")" << std::endl;
-        SetEvent(workers[next_thread]);
+// Auto-reset ping-pong pairs: each pair hands a timestamp through an event in each direction,
+// measuring the SetEvent() → WaitForEvent() wake latency on every handoff
+static void StressAutoReset(int threads, uint64_t durationMs, StressResult &result) {
+    int pairs = std::max(threads / 2, 1);
+    std::atomic<bool> stop(false);
+    std::vector<StressResult> perPair(pairs);
+    std::vector<std::thread> workers;
+
+    for (int p = 0; p < pairs; ++p) {
+        workers.push_back(std::thread([&, p] {
+            neosmart_event_t ping = CreateEvent(false, false);
+            neosmart_event_t pong = CreateEvent(false, false);
+            std::atomic<uint64_t> sentAt(0);
+
+            std::thread responder([&] {
+                for (;;) {
+                    WaitForEvent(ping);
+                    uint64_t woken = NowNs();
+                    // Answer even when stopping — the initiator may already be blocked on pong
+                    bool stopping = stop.load(std::memory_order_relaxed);
+                    if (!stopping) {
+                        perPair[p].WakeLatencies.push_back(
+                            woken - sentAt.load(std::memory_order_relaxed));
+                    }
+                    SetEvent(pong);
+                    if (stopping) {
+                        break;
+                    }
+                }
+            });
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                sentAt.store(NowNs(), std::memory_order_relaxed);
+                SetEvent(ping);
+                int waitResult = WaitForEvent(pong, 10000);
+                assert(waitResult == 0 && "Auto-reset handoff lost!");
+                (void)waitResult;
+                ++perPair[p].Operations;
+            }
+            SetEvent(ping); // Release the responder
+            responder.join();
+            DestroyEvent(ping);
+            DestroyEvent(pong);
+        }));
     }
 
-    // std::cout << "[" << index << "] Completed!" << std::endl;
-    SetEvent(done[index]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    for (auto &pair : perPair) {
+        result.Operations += pair.Operations;
+        result.WakeLatencies.insert(result.WakeLatencies.end(), pair.WakeLatencies.begin(),
+                                    pair.WakeLatencies.end());
+    }
 }
 
-int main() {
-    srand(time(NULL));
+// Manual-reset broadcast: every round must release the entire waiter population exactly once
+static void StressBroadcast(int threads, uint64_t durationMs, StressResult &result) {
+    neosmart_event_t broadcast = CreateEvent(true, false);
+    neosmart_event_t roundDone = CreateCountedEvent(0);
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> round(0);
+    std::atomic<uint64_t> sentAt(0);
+    std::vector<std::vector<uint64_t>> perThread(threads);
+    std::vector<std::thread> waiters;
 
-    for (int i = 0; i < THREADS; ++i) {
-        workers[i] = CreateEvent(false, false);
-        done[i] = CreateEvent(true, false);
+    for (int t = 0; t < threads; ++t) {
+        waiters.push_back(std::thread([&, t] {
+            uint64_t seen = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (WaitForEvent(broadcast, 100) != 0) {
+                    continue;
+                }
+                // The round counter keeps one broadcast from being counted twice by the same
+                // thread while the event is still latched
+                uint64_t current = round.load(std::memory_order_relaxed);
+                if (current == seen) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                seen = current;
+                perThread[t].push_back(NowNs() - sentAt.load(std::memory_order_relaxed));
+                ReleaseEvent(roundDone, 1);
+            }
+        }));
     }
-    shutdown = CreateEvent(true, false);
 
-    std::vector<std::thread> threads(THREADS);
-    for (int i = 0; i < THREADS; ++i) {
-        std::thread t1([i] { worker(i); });
-        threads.push_back(std::move(t1));
+    uint64_t deadline = NowNs() + durationMs * 1000 * 1000;
+    while (NowNs() < deadline) {
+        round.fetch_add(1, std::memory_order_relaxed);
+        sentAt.store(NowNs(), std::memory_order_relaxed);
+        SetEvent(broadcast);
+        for (int t = 0; t < threads; ++t) {
+            int waitResult = WaitForEvent(roundDone, 10000);
+            assert(waitResult == 0 && "Broadcast lost a waiter!");
+            (void)waitResult;
+        }
+        ResetEvent(broadcast);
+        result.Operations += threads;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 
-    // Wake the first thread
-    SetEvent(workers[0]);
+    stop.store(true, std::memory_order_relaxed);
+    SetEvent(broadcast);
+    for (auto &waiter : waiters) {
+        waiter.join();
+    }
+    DestroyEvent(roundDone);
+    DestroyEvent(broadcast);
+    for (auto &latencies : perThread) {
+        result.WakeLatencies.insert(result.WakeLatencies.end(), latencies.begin(),
+                                    latencies.end());
+    }
+}
+
+#ifdef WFMO
+// WFMO mix: each worker waits (wait-any) on a private auto-reset group plus a shared shutdown
+// event while a signaler round-robins signals across all groups; every signal must be delivered
+// to exactly one wait
+static void StressWfmo(int threads, uint64_t durationMs, StressResult &result) {
+    const int groupSize = 4;
+    std::vector<neosmart_event_t> events(threads * groupSize);
+    for (auto &event : events) {
+        event = CreateEvent(false, false);
+    }
+    neosmart_event_t shutdown = CreateEvent(true, false);
+    std::atomic<uint64_t> sentAt(0);
+    std::atomic<uint64_t> acknowledged(0);
+    std::vector<StressResult> perThread(threads);
+    std::vector<std::thread> workers;
 
-    // Wait for all threads to finish
-    int result = WaitForMultipleEvents(done, THREADS, true, 45000);
-    if (result == WAIT_TIMEOUT) {
-        std::cerr << "Timeout waiting for worker threads" << std::endl;
-        return -1;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t] {
+            neosmart_event_t group[groupSize + 1];
+            for (int i = 0; i < groupSize; ++i) {
+                group[i] = events[t * groupSize + i];
+            }
+            group[groupSize] = shutdown;
+            for (;;) {
+                int index = -1;
+                int waitResult =
+                    WaitForMultipleEvents(group, groupSize + 1, false, WAIT_INFINITE, index);
+                assert(waitResult == 0 && "WFMO wait failed under stress!");
+                (void)waitResult;
+                if (index == groupSize) {
+                    break;
+                }
+                perThread[t].WakeLatencies.push_back(
+                    NowNs() - sentAt.load(std::memory_order_relaxed));
+                ++perThread[t].Operations;
+                acknowledged.fetch_add(1, std::memory_order_relaxed);
+            }
+        }));
     }
 
-    if (WaitForEvent(shutdown, 0) == 0) {
-        return -1;
+    uint64_t deadline = NowNs() + durationMs * 1000 * 1000;
+    uint64_t sent = 0;
+    while (NowNs() < deadline) {
+        sentAt.store(NowNs(), std::memory_order_relaxed);
+        SetEvent(events[sent % events.size()]);
+        ++sent;
+        // Lockstep so a signal is never outstanding while the next timestamp is taken
+        while (acknowledged.load(std::memory_order_relaxed) < sent) {
+            std::this_thread::yield();
+        }
     }
 
+    SetEvent(shutdown);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    assert(acknowledged.load(std::memory_order_relaxed) == sent &&
+           "WFMO signal lost or duplicated under stress!");
     DestroyEvent(shutdown);
-    for (const auto &event : workers) {
+    for (auto &event : events) {
         DestroyEvent(event);
     }
-    for (const auto &event : done) {
-        DestroyEvent(event);
+    for (auto &thread : perThread) {
+        result.Operations += thread.Operations;
+        result.WakeLatencies.insert(result.WakeLatencies.end(), thread.WakeLatencies.begin(),
+                                    thread.WakeLatencies.end());
     }
+}
+#endif
 
-    for (auto &thread: threads) {
-        thread.join();
+int main() {
+    int threads = (int)EnvOr("PEVENTS_STRESS_THREADS", 8);
+    uint64_t durationMs = EnvOr("PEVENTS_STRESS_MS", 1000);
+    bool healthy = true;
+
+    {
+        StressResult result;
+        StressAutoReset(threads, durationMs, result);
+        healthy &= Report("autoreset", result, durationMs);
+    }
+    {
+        StressResult result;
+        StressBroadcast(threads, durationMs, result);
+        healthy &= Report("broadcast", result, durationMs);
     }
+#ifdef WFMO
+    {
+        StressResult result;
+        StressWfmo(threads, durationMs, result);
+        healthy &= Report("wfmo", result, durationMs);
+    }
+#endif
 
-    return 0;
+    return healthy ? 0 : 1;
 }
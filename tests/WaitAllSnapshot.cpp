@@ -0,0 +1,83 @@
+// Tests for the waitAll claim pre-pass: an all-ready wait must succeed and consume every event
+// without losing signals, and a timed-out waitAll must re-publish whatever it claimed while
+// setting up — previously-signaled events must still be signaled after the timeout.
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+
+using namespace neosmart;
+
+int main() {
+    const int count = 8;
+    neosmart_event_t events[count];
+    for (int i = 0; i < count; ++i) {
+        events[i] = CreateEvent(false, true);
+    }
+
+    // All-ready: succeeds immediately and consumes every (auto-reset) event
+    int result = WaitForMultipleEvents(events, count, true, 0);
+    assert(result == 0 && "All-signaled waitAll timed out!");
+    for (int i = 0; i < count; ++i) {
+        assert(WaitForEvent(events[i], 0) == WAIT_TIMEOUT && "waitAll did not consume event!");
+    }
+
+    // Partial-ready timeout: the signals claimed during setup must survive the failed wait
+    SetEvent(events[1]);
+    SetEvent(events[5]);
+    result = WaitForMultipleEvents(events, count, true, 0);
+    assert(result == WAIT_TIMEOUT);
+    assert(WaitForEvent(events[1], 0) == 0 && "Timed-out waitAll ate a signal!");
+    assert(WaitForEvent(events[5], 0) == 0 && "Timed-out waitAll ate a signal!");
+
+    // Same across repeated attempts with a non-zero timeout
+    SetEvent(events[3]);
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        result = WaitForMultipleEvents(events, count, true, 25);
+        assert(result == WAIT_TIMEOUT);
+    }
+    assert(WaitForEvent(events[3], 0) == 0 && "Signal lost across repeated timeouts!");
+
+#ifndef _WIN32
+    // A counted event's claimed units are restored on timeout, too
+    neosmart_event_t counted = CreateCountedEvent(2);
+    neosmart_event_t group[2] = {events[0], counted};
+    result = WaitForMultipleEvents(group, 2, true, 0);
+    assert(result == WAIT_TIMEOUT);
+    assert(WaitForEvent(counted, 0) == 0 && WaitForEvent(counted, 0) == 0 &&
+           "Timed-out waitAll ate a counted unit!");
+    assert(WaitForEvent(counted, 0) == WAIT_TIMEOUT);
+    DestroyEvent(counted);
+#endif
+
+    // A blocked waitAll still completes when the stragglers arrive
+    for (int i = 0; i < count / 2; ++i) {
+        SetEvent(events[i]);
+    }
+    std::thread straggler([&] {
+        for (int i = count / 2; i < count; ++i) {
+            SetEvent(events[i]);
+        }
+    });
+    result = WaitForMultipleEvents(events, count, true, 5000);
+    assert(result == 0 && "waitAll never completed!");
+    straggler.join();
+
+    // Manual-reset events are claimed without being consumed: still signaled after success
+    neosmart_event_t manual = CreateEvent(true, true);
+    neosmart_event_t mixed[2] = {events[0], manual};
+    SetEvent(events[0]);
+    result = WaitForMultipleEvents(mixed, 2, true, 0);
+    assert(result == 0);
+    assert(WaitForEvent(manual, 0) == 0 && "Manual-reset event consumed by waitAll!");
+    DestroyEvent(manual);
+
+    for (int i = 0; i < count; ++i) {
+        DestroyEvent(events[i]);
+    }
+
+    return 0;
+}
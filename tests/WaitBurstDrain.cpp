@@ -0,0 +1,68 @@
+// Tests for the burst-draining WFMO variants: a single call must consume every event that is
+// signaled when the wait completes (reported as a bitmask or an index span), auto-reset events
+// must actually be consumed by the sweep, and events signaled later must be left alone.
+
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+
+using namespace neosmart;
+
+int main() {
+    const int count = 8;
+    neosmart_event_t events[count];
+    for (int i = 0; i < count; ++i) {
+        events[i] = CreateEvent(false, false);
+    }
+
+    // Nothing signaled: the mask form times out with an empty mask
+    uint64_t mask = ~(uint64_t)0;
+    int result = WaitForMultipleEvents(events, count, false, 0, mask);
+    assert(result == WAIT_TIMEOUT && mask == 0 && "Timed-out burst wait reported a mask!");
+
+    // A burst of pre-signaled events is consumed in one pass
+    SetEvent(events[1]);
+    SetEvent(events[4]);
+    SetEvent(events[6]);
+    result = WaitForMultipleEvents(events, count, false, WAIT_INFINITE, mask);
+    assert(result == 0 && "Burst wait failed!");
+    assert(mask == ((1u << 1) | (1u << 4) | (1u << 6)) && "Burst mask mismatch!");
+    // The sweep consumed the auto-reset signals, not just observed them
+    for (int i = 0; i < count; ++i) {
+        assert(WaitForEvent(events[i], 0) == WAIT_TIMEOUT && "Swept event still signaled!");
+    }
+
+    // The span form reports the same thing for arbitrary counts
+    SetEvent(events[0]);
+    SetEvent(events[7]);
+    int signaled[count];
+    int signaledCount = -1;
+    result = WaitForMultipleEvents(events, count, false, WAIT_INFINITE, signaled, signaledCount);
+    assert(result == 0 && signaledCount == 2 && "Burst span wait failed!");
+    assert(signaled[0] == 0 && signaled[1] == 7 && "Burst span mismatch!");
+
+    // A late signal wakes the wait and is the only thing reported
+    std::thread signaler([&] { SetEvent(events[3]); });
+    result = WaitForMultipleEvents(events, count, false, WAIT_INFINITE, mask);
+    signaler.join();
+    assert(result == 0 && (mask & (1u << 3)) != 0 && "Late signal missing from burst mask!");
+
+    // Manual-reset events are reported but stay signaled, like any other wait against them
+    neosmart_event_t manual = CreateEvent(true, true);
+    neosmart_event_t mixed[2] = {events[0], manual};
+    result = WaitForMultipleEvents(mixed, 2, false, 0, mask);
+    assert(result == 0 && mask == (1u << 1) && "Manual-reset event missing from burst mask!");
+    assert(WaitForEvent(manual, 0) == 0 && "Burst sweep consumed a manual-reset event!");
+    DestroyEvent(manual);
+
+    // waitAll reports the full mask
+    SetEvents(events, count);
+    result = WaitForMultipleEvents(events, count, true, WAIT_INFINITE, mask);
+    assert(result == 0 && mask == ((1u << count) - 1) && "waitAll burst mask incomplete!");
+
+    for (int i = 0; i < count; ++i) {
+        DestroyEvent(events[i]);
+    }
+
+    return 0;
+}
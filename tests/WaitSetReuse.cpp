@@ -0,0 +1,86 @@
+// Tests for the reusable wait-set API: the standing registrations must survive and correctly
+// account repeated waits (both waitAny and waitAll), including waits resolved by the pre-check
+// fast path (event already signaled) and waits resolved by a signal arriving mid-wait.
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+
+using namespace neosmart;
+
+int main() {
+    const int count = 4;
+    neosmart_event_t events[count];
+    for (int i = 0; i < count; ++i) {
+        events[i] = CreateEvent(false, false);
+    }
+
+    neosmart_waitset_t waitset = CreateWaitSet(events, count);
+
+    // An unsignaled wait-set should time out without disturbing the registrations
+    int result = WaitForWaitSet(waitset, false, 0);
+    assert(result == WAIT_TIMEOUT && "Wait against unsignaled wait-set did not time out!");
+
+    // waitAny resolved by the pre-check: signal before waiting, repeatedly, round-robin
+    for (int round = 0; round < 100; ++round) {
+        int expected = round % count;
+        SetEvent(events[expected]);
+
+        int index = -1;
+        result = WaitForWaitSet(waitset, false, WAIT_INFINITE, index);
+        assert(result == 0 && "WaitForWaitSet() call failed!");
+        assert(index == expected && "Wrong event index reported by wait-set!");
+    }
+
+    // Each auto-reset event should have been consumed by exactly one wait
+    for (int i = 0; i < count; ++i) {
+        result = WaitForEvent(events[i], 0);
+        assert(result == WAIT_TIMEOUT && "Auto-reset event not consumed by wait-set wait!");
+    }
+
+    // waitAny resolved by a signal arriving while the waiter is blocked
+    for (int round = 0; round < 100; ++round) {
+        int expected = round % count;
+        std::thread signaler([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            SetEvent(events[expected]);
+        });
+
+        int index = -1;
+        result = WaitForWaitSet(waitset, false, WAIT_INFINITE, index);
+        assert(result == 0 && "WaitForWaitSet() call failed!");
+        assert(index == expected && "Wrong event index reported by wait-set!");
+        signaler.join();
+    }
+
+    // waitAll across repeated waits, mixing pre-signaled and late-signaled events
+    for (int round = 0; round < 100; ++round) {
+        SetEvent(events[0]);
+        SetEvent(events[1]);
+        std::thread signaler([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            for (int i = 2; i < count; ++i) {
+                SetEvent(events[i]);
+            }
+        });
+
+        result = WaitForWaitSet(waitset, true, WAIT_INFINITE);
+        assert(result == 0 && "waitAll WaitForWaitSet() call failed!");
+        signaler.join();
+    }
+
+    // Events must remain usable (and correctly unregistered) after the wait-set is destroyed
+    DestroyWaitSet(waitset);
+    SetEvent(events[0]);
+    result = WaitForEvent(events[0], 0);
+    assert(result == 0 && "Event unusable after DestroyWaitSet()!");
+
+    for (int i = 0; i < count; ++i) {
+        DestroyEvent(events[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+// Tests for the absolute-deadline waits (WaitForEventUntil / WaitForMultipleEventsUntil): one
+// CLOCK_MONOTONIC read can be shared across a whole retry loop, the deadline is honored as a
+// point in time rather than a duration, and a deadline already in the past degrades to a poll.
+
+#ifdef _WIN32
+// The deadline API is POSIX-only; Windows callers keep the millisecond overloads
+int main() {
+    return 0;
+}
+#else
+
+#include <cassert>
+#include <chrono>
+#include <pevents.h>
+#include <thread>
+#include <time.h>
+
+using namespace neosmart;
+
+static timespec DeadlineIn(long milliseconds) {
+    timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += milliseconds / 1000;
+    deadline.tv_nsec += (milliseconds % 1000) * 1000 * 1000;
+    if (deadline.tv_nsec >= 1000 * 1000 * 1000) {
+        deadline.tv_nsec -= 1000 * 1000 * 1000;
+        deadline.tv_sec += 1;
+    } else if (deadline.tv_nsec < 0) {
+        // A negative offset can underflow the nanosecond field; keep the timespec normalized
+        // (tv_nsec in [0, 1e9)) as pthread_cond_timedwait() requires
+        deadline.tv_nsec += 1000 * 1000 * 1000;
+        deadline.tv_sec -= 1;
+    }
+    return deadline;
+}
+
+static uint64_t NowMilliseconds() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / (1000 * 1000);
+}
+
+int main() {
+    neosmart_event_t event = CreateEvent(false, false);
+
+    // An already-signaled event completes regardless of the deadline
+    SetEvent(event);
+    assert(WaitForEventUntil(event, DeadlineIn(0)) == 0 && "Signaled wait-until failed!");
+
+    // A deadline in the past behaves like a zero-millisecond wait
+    assert(WaitForEventUntil(event, DeadlineIn(-100)) == WAIT_TIMEOUT &&
+           "Expired deadline did not time out!");
+
+    // The deadline is a point in time: the wait returns once it passes, not some duration later
+    uint64_t before = NowMilliseconds();
+    assert(WaitForEventUntil(event, DeadlineIn(100)) == WAIT_TIMEOUT &&
+           "Unsignaled wait-until did not time out!");
+    uint64_t elapsed = NowMilliseconds() - before;
+    assert(elapsed >= 90 && elapsed < 2000 && "Deadline not honored!");
+
+    // A signal arriving before the deadline completes the wait
+    std::thread signaler([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        SetEvent(event);
+    });
+    assert(WaitForEventUntil(event, DeadlineIn(5000)) == 0 && "Wait-until missed a signal!");
+    signaler.join();
+
+    // One deadline shared across a retry loop: the overall budget holds no matter how many
+    // times the wait is re-entered (the pattern the API exists for)
+    timespec deadline = DeadlineIn(150);
+    before = NowMilliseconds();
+    int attempts = 0;
+    while (WaitForEventUntil(event, deadline) == 0) {
+        ++attempts;
+    }
+    elapsed = NowMilliseconds() - before;
+    assert(attempts == 0 && "Retry loop consumed a phantom signal!");
+    assert(elapsed >= 140 && elapsed < 2000 && "Shared deadline not honored across retries!");
+
+#ifdef WFMO
+    neosmart_event_t pair[2] = {event, CreateEvent(false, false)};
+
+    // Deadline wait-any: an already-signaled member completes, a bare group times out on time
+    SetEvent(pair[1]);
+    int index = -1;
+    assert(WaitForMultipleEventsUntil(pair, 2, false, DeadlineIn(0), index) == 0 && index == 1 &&
+           "Signaled deadline wait-any failed!");
+    before = NowMilliseconds();
+    assert(WaitForMultipleEventsUntil(pair, 2, false, DeadlineIn(100)) == WAIT_TIMEOUT &&
+           "Unsignaled deadline wait-any did not time out!");
+    elapsed = NowMilliseconds() - before;
+    assert(elapsed >= 90 && elapsed < 2000 && "Wait-any deadline not honored!");
+
+    // Deadline wait-all: a partial group times out and re-publishes what it claimed
+    SetEvent(pair[0]);
+    assert(WaitForMultipleEventsUntil(pair, 2, true, DeadlineIn(50)) == WAIT_TIMEOUT &&
+           "Partial deadline wait-all did not time out!");
+    assert(WaitForEvent(pair[0], 0) == 0 && "Timed-out deadline wait-all ate a signal!");
+
+    // ... and completes when a late signal fills the group before the deadline
+    SetEvent(pair[0]);
+    std::thread filler([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        SetEvent(pair[1]);
+    });
+    assert(WaitForMultipleEventsUntil(pair, 2, true, DeadlineIn(5000)) == 0 &&
+           "Deadline wait-all missed a late signal!");
+    filler.join();
+
+    DestroyEvent(pair[1]);
+#endif
+
+    DestroyEvent(event);
+
+    return 0;
+}
+#endif // _WIN32
@@ -0,0 +1,80 @@
+// Tests for waitable timers: a timer handle must be waitable like any other event, fire after
+// its due time (and every period thereafter for periodic timers), and honor re-arming and
+// cancellation. Timing assertions are deliberately loose — only ordering and "fired vs. not
+// fired within a generous window" are checked, never exact latencies.
+
+#ifndef _WIN32
+
+#include <cassert>
+#include <pevents.h>
+
+using namespace neosmart;
+
+int main() {
+    // One-shot: not signaled before the due time has plausibly arrived, signaled within a
+    // generous window after it, and (auto-reset) consumed by the wait
+    neosmart_event_t oneshot = CreateWaitableTimer(50);
+    assert(WaitForEvent(oneshot, 0) == WAIT_TIMEOUT && "Timer fired before its due time!");
+    assert(WaitForEvent(oneshot, 5000) == 0 && "One-shot timer never fired!");
+    assert(WaitForEvent(oneshot, 200) == WAIT_TIMEOUT && "One-shot timer fired twice!");
+
+    // Re-arming a fired one-shot makes it fire again
+    assert(SetWaitableTimer(oneshot, 10) == 0);
+    assert(WaitForEvent(oneshot, 5000) == 0 && "Re-armed timer never fired!");
+    assert(DestroyWaitableTimer(oneshot) == 0);
+
+    // Periodic: keeps firing, one (auto-reset) release per period
+    neosmart_event_t periodic = CreateWaitableTimer(10, 10);
+    for (int i = 0; i < 5; ++i) {
+        assert(WaitForEvent(periodic, 5000) == 0 && "Periodic timer stopped firing!");
+    }
+
+    // Cancellation disarms without destroying: drain any pending firing, then nothing more
+    assert(CancelWaitableTimer(periodic) == 0);
+    WaitForEvent(periodic, 0);
+    assert(WaitForEvent(periodic, 100) == WAIT_TIMEOUT && "Cancelled timer still fired!");
+
+    // A cancelled timer can be re-armed
+    assert(SetWaitableTimer(periodic, 10) == 0);
+    assert(WaitForEvent(periodic, 5000) == 0 && "Re-armed cancelled timer never fired!");
+    assert(DestroyWaitableTimer(periodic) == 0);
+
+    // Manual-reset timers latch until explicitly reset
+    neosmart_event_t latched = CreateWaitableTimer(10, 0, true);
+    assert(WaitForEvent(latched, 5000) == 0);
+    assert(WaitForEvent(latched, 0) == 0 && "Manual-reset timer did not latch!");
+    ResetEvent(latched);
+    assert(WaitForEvent(latched, 100) == WAIT_TIMEOUT);
+    assert(DestroyWaitableTimer(latched) == 0);
+
+    // Timer API calls against a plain event (or a destroyed timer) are rejected
+    neosmart_event_t plain = CreateEvent();
+    assert(SetWaitableTimer(plain, 10) != 0 && "Re-armed a non-timer event!");
+    assert(CancelWaitableTimer(plain) != 0);
+    assert(DestroyWaitableTimer(plain) != 0);
+    DestroyEvent(plain);
+
+#ifdef WFMO
+    // A timer participates in a WFMO group like any other event
+    neosmart_event_t timer = CreateWaitableTimer(20);
+    neosmart_event_t decoy = CreateEvent();
+    neosmart_event_t events[2] = {decoy, timer};
+    int index = -1;
+    int result = WaitForMultipleEvents(events, 2, false, 5000, index);
+    assert(result == 0 && index == 1 && "Timer not delivered through WFMO!");
+    (void)result;
+    DestroyEvent(decoy);
+    assert(DestroyWaitableTimer(timer) == 0);
+#endif
+
+    return 0;
+}
+
+#else
+
+// Not applicable to Windows, where native kernel waitable timers fill this role
+int main() {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,74 @@
+// Tests for WaitForMultipleEvents() beyond 64 events: the POSIX implementation takes any count
+// natively and the Windows implementation chunks past MAXIMUM_WAIT_OBJECTS, so the same wide
+// waits must work identically on both platforms.
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <cassert>
+#include <pevents.h>
+#include <thread>
+#include <vector>
+
+using namespace neosmart;
+
+int main() {
+    const int count = 200;
+    std::vector<neosmart_event_t> events(count);
+    for (auto &event : events) {
+        event = CreateEvent(false, false);
+    }
+
+    // Wide wait-any: an unsignaled group times out without consuming anything
+    int index = -1;
+    int result = WaitForMultipleEvents(events.data(), count, false, 100, index);
+    assert(result == WAIT_TIMEOUT && "Unsignaled wide wait-any did not time out!");
+
+    // A pre-signaled event deep in the array is found and consumed
+    SetEvent(events[137]);
+    result = WaitForMultipleEvents(events.data(), count, false, 5000, index);
+    assert(result == 0 && index == 137 && "Wide wait-any missed a signaled event!");
+    assert(WaitForEvent(events[137], 0) == WAIT_TIMEOUT && "Signal not consumed!");
+
+    // A signal arriving while blocked wakes the wide wait
+    std::thread signaler([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        SetEvent(events[190]);
+    });
+    result = WaitForMultipleEvents(events.data(), count, false, 5000, index);
+    assert(result == 0 && index == 190 && "Wide wait-any missed a late signal!");
+    signaler.join();
+
+    // Repeated wide waits reuse whatever per-call machinery the platform caches
+    for (int round = 0; round < 25; ++round) {
+        SetEvent(events[round * 7 % count]);
+        result = WaitForMultipleEvents(events.data(), count, false, 5000, index);
+        assert(result == 0 && index == round * 7 % count && "Wide wait-any round failed!");
+    }
+
+    // Wide wait-all: succeeds with everything set, consuming every auto-reset signal
+    for (auto &event : events) {
+        SetEvent(event);
+    }
+    result = WaitForMultipleEvents(events.data(), count, true, 5000);
+    assert(result == 0 && "All-signaled wide wait-all failed!");
+    for (auto &event : events) {
+        assert(WaitForEvent(event, 0) == WAIT_TIMEOUT && "Wide wait-all left a signal behind!");
+    }
+
+    // Wide wait-all timeout: signals consumed during the attempt are re-published
+    for (int i = 0; i < 100; ++i) {
+        SetEvent(events[i]);
+    }
+    result = WaitForMultipleEvents(events.data(), count, true, 100);
+    assert(result == WAIT_TIMEOUT && "Partially-signaled wide wait-all did not time out!");
+    for (int i = 0; i < 100; ++i) {
+        assert(WaitForEvent(events[i], 0) == 0 && "Timed-out wide wait-all ate a signal!");
+    }
+
+    for (auto &event : events) {
+        DestroyEvent(event);
+    }
+
+    return 0;
+}